@@ -509,6 +509,23 @@ Amr::InitAmr ()
 
     loadbalance_max_fac = 1.5;
     pp.query("loadbalance_max_fac", loadbalance_max_fac);
+
+    pp.query("use_task_graph", use_task_graph);
+    pp.query("task_trace_file", task_trace_file);
+    if (!task_trace_file.empty()) {
+        use_task_graph = true;
+        task_graph.setTrace(true);
+    }
+}
+
+void
+Amr::runTask (std::string const& name, int level, std::function<void()> const& f)
+{
+    if (use_task_graph) {
+        task_graph.addTask(name, level, f);
+    } else {
+        f();
+    }
 }
 
 int
@@ -722,6 +739,11 @@ Amr::deleteDeriveSmallPlotVar (const std::string& name)
 
 Amr::~Amr ()
 {
+    task_graph.clear();
+    if (!task_trace_file.empty()) {
+        task_graph.writeTrace(task_trace_file);
+    }
+
     levelbld->variableCleanUp();
 
     Amr::Finalize();
@@ -1955,7 +1977,7 @@ Amr::timeStep (int  level,
 
             if (okToRegrid(i))
             {
-                regrid(i,time);
+                runTask("regrid", i, [&] () { regrid(i,time); });
 
                 //
                 // Compute new dt after regrid if at level 0 and compute_new_dt_on_regrid.
@@ -2021,7 +2043,11 @@ Amr::timeStep (int  level,
                        << " with dt = " << dt_level[level] << "\n";
     }
 
-    Real dt_new = amr_level[level]->advance(time,dt_level[level],iteration,niter);
+    Real dt_new = 0.0_rt;
+    runTask("advance", level, [&] ()
+    {
+        dt_new = amr_level[level]->advance(time,dt_level[level],iteration,niter);
+    });
     BL_PROFILE_REGION_STOP("amr_level.advance");
 
     dt_min[level] = iteration == 1 ? dt_new : std::min(dt_min[level],dt_new);
@@ -2041,7 +2067,7 @@ Amr::timeStep (int  level,
 
         int old_finest = finest_level;
 
-        regrid(level, time);
+        runTask("regrid", level, [&] () { regrid(level, time); });
 
         if (old_finest < finest_level)
         {
@@ -2078,7 +2104,7 @@ Amr::timeStep (int  level,
         }
     }
 
-    amr_level[level]->post_timestep(iteration);
+    runTask("post_timestep", level, [&] () { amr_level[level]->post_timestep(iteration); });
 
     // Set this back to negative so we know whether we are in fact in this routine
     which_level_being_advanced = -1;
@@ -2108,15 +2134,18 @@ Amr::coarseTimeStep (Real stop_time)
     //
     if (levelSteps(0) > 0)
     {
-        int post_regrid_flag = 0;
-        amr_level[0]->computeNewDt(finest_level,
-                                   sub_cycle,
-                                   n_cycle,
-                                   ref_ratio,
-                                   dt_min,
-                                   dt_level,
-                                   stop_time,
-                                   post_regrid_flag);
+        runTask("computeNewDt", 0, [&] ()
+        {
+            int post_regrid_flag = 0;
+            amr_level[0]->computeNewDt(finest_level,
+                                       sub_cycle,
+                                       n_cycle,
+                                       ref_ratio,
+                                       dt_min,
+                                       dt_level,
+                                       stop_time,
+                                       post_regrid_flag);
+        });
     }
     else
     {
@@ -2132,6 +2161,8 @@ Amr::coarseTimeStep (Real stop_time)
     timeStep(0,cumtime,1,1,stop_time);
     BL_PROFILE_REGION_STOP(stepName.str());
 
+    task_graph.clear();
+
     cumtime += dt_level[0];
 
     // sync up statedata time
@@ -2142,7 +2173,7 @@ Amr::coarseTimeStep (Real stop_time)
         }
     }
 
-    amr_level[0]->postCoarseTimeStep(cumtime);
+    runTask("postCoarseTimeStep", 0, [&] () { amr_level[0]->postCoarseTimeStep(cumtime); });
 
     if (verbose > 0)
     {
@@ -2326,18 +2357,18 @@ Amr::coarseTimeStep (Real stop_time)
     if ((check_int > 0 && level_steps[0] % check_int == 0) || check_test == 1
         || to_checkpoint)
     {
-        checkPoint();
+        runTask("checkPoint", -1, [&] () { checkPoint(); });
     }
 
 
     if (writePlotNow() || to_plot)
     {
-        writePlotFile();
+        runTask("writePlotFile", -1, [&] () { writePlotFile(); });
     }
 
     if (writeSmallPlotNow() || to_small_plot)
     {
-        writeSmallPlotFile();
+        runTask("writeSmallPlotFile", -1, [&] () { writeSmallPlotFile(); });
     }
 
     updateInSitu();
@@ -2575,6 +2606,9 @@ Amr::regrid (int  lbase,
 
     if (lbase > std::min(finest_level,max_level-1)) { return; }
 
+    // Asynchronous tasks may still be using the old data.
+    task_graph.finish();
+
     if (verbose > 0) {
         amrex::Print() << "Now regridding at level lbase = " << lbase << "\n";
     }
@@ -2651,7 +2685,13 @@ Amr::regrid (int  lbase,
             new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
         }
         else if (new_dmap[lev].empty()) {
-            new_dmap[lev].define(new_grid_places[lev]);
+            if (reuse_unchanged_grids && !initial && amr_level[lev]) {
+                new_dmap[lev] = DistributionMapping::makeIncremental
+                    (new_grid_places[lev], amr_level[lev]->boxArray(),
+                     amr_level[lev]->DistributionMap());
+            } else {
+                new_dmap[lev].define(new_grid_places[lev]);
+            }
         }
 
         AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),new_grid_places[lev],
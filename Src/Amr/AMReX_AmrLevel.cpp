@@ -2196,11 +2196,40 @@ AmrLevel::FillPatch (AmrLevel& amrlevel,
     BL_PROFILE("AmrLevel::FillPatch()");
     BL_ASSERT(dcomp+ncomp-1 <= leveldata.nComp());
     BL_ASSERT(leveldata.nGrowVect().allGE(boxGrow));
+
     FillPatchIterator fpi(amrlevel, leveldata, boxGrow, time, index, scomp, ncomp);
     const MultiFab& mf_fillpatched = fpi.get_mf();
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+void
+AmrLevel::FillPatchIncremental (AmrLevel& old,
+                                MultiFab& leveldata,
+                                Real      time,
+                                int       index,
+                                int       scomp,
+                                int       ncomp,
+                                int       dcomp)
+{
+    BL_PROFILE("AmrLevel::FillPatchIncremental()");
+    BL_ASSERT(dcomp+ncomp-1 <= leveldata.nComp());
+
+    if (scomp == 0 && dcomp == 0
+        && old.state[index].hasNewData()
+        && ncomp == leveldata.nComp()
+        && ncomp == old.get_new_data(index).nComp()
+        && old.state[index].curTime() == time)
+    {
+        amrex::FillPatchIncremental(leveldata, old.get_new_data(index),
+                                    [&] (MultiFab& mf)
+        {
+            FillPatch(old, mf, 0, time, index, 0, ncomp);
+        });
+    } else {
+        FillPatch(old, leveldata, 0, time, index, scomp, ncomp, dcomp);
+    }
+}
+
 void
 AmrLevel::FillPatchAdd (AmrLevel& amrlevel,
                         MultiFab& leveldata,
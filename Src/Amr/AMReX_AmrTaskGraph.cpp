@@ -0,0 +1,158 @@
+#include <AMReX_AmrTaskGraph.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <fstream>
+#include <iomanip>
+
+namespace amrex {
+
+namespace {
+    // Escape a task name for a JSON string.
+    std::string json_escape (std::string const& s)
+    {
+        std::string r;
+        r.reserve(s.size());
+        for (char c : s) {
+            switch (c) {
+            case '"':  r += "\\\""; break;
+            case '\\': r += "\\\\"; break;
+            case '\b': r += "\\b"; break;
+            case '\f': r += "\\f"; break;
+            case '\n': r += "\\n"; break;
+            case '\r': r += "\\r"; break;
+            case '\t': r += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr char hex[] = "0123456789abcdef";
+                    r += "\\u00";
+                    r += hex[(c >> 4) & 0xf];
+                    r += hex[c & 0xf];
+                } else {
+                    r += c;
+                }
+            }
+        }
+        return r;
+    }
+}
+
+AmrTaskGraph::~AmrTaskGraph ()
+{
+    finish();
+}
+
+int
+AmrTaskGraph::addTask (std::string name, int level, std::function<void()> f,
+                       Vector<int> const& deps, bool async)
+{
+    if (m_t0 < 0.0) { m_t0 = amrex::second(); }
+
+    m_tasks.emplace_back();
+    Task& task = m_tasks.back();
+    task.name = std::move(name);
+    task.level = level;
+    task.async = async;
+    const int id = lastTask();
+
+    if (async) {
+        // The background thread runs the tasks in the order they are
+        // submitted, so only the synchronous dependencies need waiting for.
+        for (int d : deps) {
+            AMREX_ASSERT(d < id);
+            if (d >= m_first && !m_tasks[d-m_first].async) { wait(d); }
+        }
+        if (!m_bg) { m_bg = std::make_unique<BackgroundThread>(); }
+        m_bg->Submit([&task, f=std::move(f)] ()
+        {
+            task.t_start = amrex::second();
+            f();
+            task.t_stop = amrex::second();
+            task.done = true;
+        });
+    } else {
+        for (int d : deps) {
+            AMREX_ASSERT(d < id);
+            wait(d);
+        }
+        task.t_start = amrex::second();
+        f();
+        task.t_stop = amrex::second();
+        task.done = true;
+    }
+
+    return id;
+}
+
+bool
+AmrTaskGraph::isDone (int task) const noexcept
+{
+    return (task < m_first) || m_tasks[task-m_first].done;
+}
+
+void
+AmrTaskGraph::wait (int task)
+{
+    if (!isDone(task)) {
+        AMREX_ASSERT(m_bg);
+        m_bg->Finish();
+    }
+}
+
+void
+AmrTaskGraph::finish ()
+{
+    if (m_bg) { m_bg->Finish(); }
+}
+
+void
+AmrTaskGraph::clear ()
+{
+    finish();
+    if (m_trace) {
+        for (auto const& task : m_tasks) {
+            m_events.push_back({task.name, task.level, task.async,
+                                task.t_start-m_t0, task.t_stop-m_t0});
+        }
+    }
+    m_first += static_cast<int>(m_tasks.size());
+    m_tasks.clear();
+}
+
+void
+AmrTaskGraph::writeTrace (std::string const& filename) const
+{
+    const int myproc = ParallelDescriptor::MyProc();
+    std::ofstream ofs(amrex::Concatenate(filename, myproc, 5));
+    if (!ofs.good()) {
+        amrex::FileOpenFailed(amrex::Concatenate(filename, myproc, 5));
+    }
+
+    // Times are in microseconds.  The asynchronous tasks are shown as a
+    // separate thread.
+    ofs << std::setprecision(15) << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto write_event = [&] (std::string const& name, int level, bool async,
+                            double t_start, double t_stop)
+    {
+        if (!first) { ofs << ",\n"; }
+        first = false;
+        ofs << "{\"name\":\"" << json_escape(name) << "\",\"ph\":\"X\""
+            << ",\"ts\":" << t_start*1.e6 << ",\"dur\":" << (t_stop-t_start)*1.e6
+            << ",\"pid\":" << myproc << ",\"tid\":" << (async ? 1 : 0)
+            << ",\"args\":{\"level\":" << level << "}}";
+    };
+    for (auto const& e : m_events) {
+        write_event(e.name, e.level, e.async, e.t_start, e.t_stop);
+    }
+    for (auto const& task : m_tasks) {
+        if (task.done) {
+            write_event(task.name, task.level, task.async,
+                        task.t_start-m_t0, task.t_stop-m_t0);
+        }
+    }
+    ofs << "\n]}\n";
+}
+
+}
@@ -103,7 +103,9 @@ AmrCore::regrid (int lbase, Real time, bool)
                 DistributionMapping level_dmap = dmap[lev];
                 if (ba_changed) {
                     level_grids = new_grids[lev];
-                    level_dmap = MakeDistributionMap(lev, level_grids);
+                    level_dmap = reuse_unchanged_grids
+                        ? DistributionMapping::makeIncremental(level_grids, grids[lev], dmap[lev])
+                        : MakeDistributionMap(lev, level_grids);
                 }
                 const auto old_num_setdm = num_setdm;
                 RemakeLevel(lev, time, level_grids, level_dmap);
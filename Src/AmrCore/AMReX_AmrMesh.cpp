@@ -376,6 +376,10 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     pp.queryAdd("check_input", check_input);
 
+    pp.queryAdd("use_distributed_clustering", use_distributed_clustering);
+
+    pp.queryAdd("reuse_unchanged_grids", reuse_unchanged_grids);
+
     finest_level = -1;
 
 #ifdef AMREX_USE_BITTREE
@@ -733,10 +737,19 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         // Create initial cluster containing all tagged points.
         //
         Gpu::PinnedVector<IntVect> tagvec;
-        tags.collate(tagvec);
+        bool has_tags;
+        if (use_distributed_clustering) {
+            tags.local_collate(tagvec);
+            auto ntags = static_cast<Long>(tagvec.size());
+            ParallelDescriptor::ReduceLongSum(ntags);
+            has_tags = ntags > 0;
+        } else {
+            tags.collate(tagvec);
+            has_tags = !tagvec.empty();
+        }
         tags.clear();
 
-        if (!tagvec.empty())
+        if (has_tags)
         {
             //
             // Created new level, now generate efficient grids.
@@ -747,23 +760,31 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
 
             if (levf > useFixedUpToLevel()) {
                 BoxList new_bx;
-                if (ParallelDescriptor::IOProcessor()) {
-                    BL_PROFILE("AmrMesh-cluster");
+                if (use_distributed_clustering) {
+                    BL_PROFILE("AmrMesh-cluster-distributed");
                     //
-                    // Construct initial cluster.
+                    // Cluster the local tags.  Tags are not duplicated
+                    // across processes.
                     //
-                    ClusterList clist(tagvec.data(), static_cast<Long>(tagvec.size()));
-                    if (use_new_chop) {
-                        clist.new_chop(grid_eff);
-                    } else {
-                        clist.chop(grid_eff);
+                    if (!tagvec.empty()) {
+                        ClusterList clist(tagvec.data(), static_cast<Long>(tagvec.size()));
+                        if (use_new_chop) {
+                            clist.new_chop(grid_eff);
+                        } else {
+                            clist.chop(grid_eff);
+                        }
+                        clist.intersect(p_n_ba[levc]);
+                        clist.boxList(new_bx);
                     }
-                    clist.intersect(p_n_ba[levc]);
                     //
-                    // Efficient properly nested Clusters have been constructed
-                    // now generate list of grids at level levf.
+                    // Gather the clusters of all processes and merge them.
+                    // Clusters of different processes may overlap, because
+                    // the bounding box of the tags of one process can
+                    // extend over the grids of another.
                     //
-                    clist.boxList(new_bx);
+                    Vector<Box> bxs(new_bx.begin(), new_bx.end());
+                    amrex::AllGatherBoxes(bxs);
+                    new_bx = amrex::removeOverlap(BoxList(std::move(bxs)));
                     new_bx.refine(bf_lev[levc]);
                     new_bx.simplify();
 
@@ -771,8 +792,34 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                         // Chop new grids outside domain
                         new_bx.intersect(Geom(levc).Domain());
                     }
+                } else {
+                    if (ParallelDescriptor::IOProcessor()) {
+                        BL_PROFILE("AmrMesh-cluster");
+                        //
+                        // Construct initial cluster.
+                        //
+                        ClusterList clist(tagvec.data(), static_cast<Long>(tagvec.size()));
+                        if (use_new_chop) {
+                            clist.new_chop(grid_eff);
+                        } else {
+                            clist.chop(grid_eff);
+                        }
+                        clist.intersect(p_n_ba[levc]);
+                        //
+                        // Efficient properly nested Clusters have been constructed
+                        // now generate list of grids at level levf.
+                        //
+                        clist.boxList(new_bx);
+                        new_bx.refine(bf_lev[levc]);
+                        new_bx.simplify();
+
+                        if (new_bx.size()>0) {
+                            // Chop new grids outside domain
+                            new_bx.intersect(Geom(levc).Domain());
+                        }
+                    }
+                    new_bx.Bcast();  // Broadcast the new BoxList to other processes
                 }
-                new_bx.Bcast();  // Broadcast the new BoxList to other processes
 
                 bool odd_ref_ratio = false;
                 for (auto const& rr : ref_ratio[levc]) {
@@ -1256,6 +1303,8 @@ std::ostream& operator<< (std::ostream& os, AmrMesh const& amr_mesh)
     os << "  refine_grid_layout_dims = " << amr_mesh.refine_grid_layout_dims << "\n";
     os << "  check_input = " << amr_mesh.check_input  << "\n";
     os << "  use_new_chop = " << amr_mesh.use_new_chop << "\n";
+    os << "  use_distributed_clustering = " << amr_mesh.use_distributed_clustering << "\n";
+    os << "  reuse_unchanged_grids = " << amr_mesh.reuse_unchanged_grids << "\n";
     os << "  iterate_on_new_grids = " << amr_mesh.iterate_on_new_grids << "\n";
     return os;
 }
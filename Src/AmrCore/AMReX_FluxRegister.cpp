@@ -5,6 +5,7 @@
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_BLProfiler.H>
 #include <AMReX_iMultiFab.H>
+#include <AMReX_MultiFabUtil.H>
 
 namespace amrex {
 
@@ -71,6 +72,10 @@ FluxRegister::define (const BoxArray&            fine_boxes,
     grids = fine_boxes;
     grids.coarsen(ratio);
 
+    // The boxes for BatchedReflux depend on the grids.
+    m_reflux_ba = BoxArray();
+    m_reflux_dm = DistributionMapping();
+
     for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
     {
         const Orientation lo_face(dir,Orientation::low);
@@ -89,6 +94,8 @@ void
 FluxRegister::clear ()
 {
     BndryRegister::clear();
+    m_reflux_ba = BoxArray();
+    m_reflux_dm = DistributionMapping();
 }
 
 Real
@@ -640,6 +647,437 @@ FluxRegister::Reflux (MultiFab& mf, const MultiFab& volume, Orientation face,
     }
 }
 
+void
+FluxRegister::scaleFluxes (Array<MultiFab,AMREX_SPACEDIM>& mf,
+                           const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                           const Array<MultiFab const*,AMREX_SPACEDIM>& area,
+                           int srccomp, int numcomp, Real mult) const
+{
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+    {
+        BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx[dir]->nComp());
+
+        mf[dir].define(mflx[dir]->boxArray(), mflx[dir]->DistributionMap(), numcomp, 0,
+                       MFInfo(), mflx[dir]->Factory());
+
+        MultiFab const* pa = area[dir];
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion() && mflx[dir]->isFusingCandidate()) {
+            auto const& dma = mf[dir].arrays();
+            auto const& sma = mflx[dir]->const_arrays();
+            if (pa) {
+                auto const& ama = pa->const_arrays();
+                ParallelFor(mf[dir], IntVect(0), numcomp,
+                [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k, int n) noexcept
+                {
+                    dma[box_no](i,j,k,n) = sma[box_no](i,j,k,n+srccomp)*mult*ama[box_no](i,j,k);
+                });
+            } else {
+                ParallelFor(mf[dir], IntVect(0), numcomp,
+                [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k, int n) noexcept
+                {
+                    dma[box_no](i,j,k,n) = sma[box_no](i,j,k,n+srccomp)*mult;
+                });
+            }
+        } else
+#endif
+        {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(mf[dir],TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+                auto       dfab = mf[dir].array(mfi);
+                auto const sfab = mflx[dir]->const_array(mfi);
+                if (pa) {
+                    auto const afab = pa->const_array(mfi);
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, numcomp, i, j, k, n,
+                    {
+                        dfab(i,j,k,n) = sfab(i,j,k,n+srccomp)*mult*afab(i,j,k);
+                    });
+                } else {
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, numcomp, i, j, k, n,
+                    {
+                        dfab(i,j,k,n) = sfab(i,j,k,n+srccomp)*mult;
+                    });
+                }
+            }
+        }
+    }
+}
+
+void
+FluxRegister::CrseInit (const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                        const Array<MultiFab const*,AMREX_SPACEDIM>& area,
+                        int  srccomp,
+                        int  destcomp,
+                        int  numcomp,
+                        Real mult,
+                        FrOp op)
+{
+    BL_PROFILE("FluxRegister::CrseInit(batched)");
+    BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
+
+    Array<MultiFab,AMREX_SPACEDIM> mf;
+    scaleFluxes(mf, mflx, area, srccomp, numcomp, mult);
+
+    Vector<FabSet> fs;
+    if (op == FluxRegister::ADD) {
+        fs.resize(2*AMREX_SPACEDIM);
+    }
+
+    // Start the communication for all faces before waiting for any.
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const Orientation face = fi();
+        const int dir = face.coordDir();
+        if (op == FluxRegister::COPY) {
+            bndry[face].multiFab().ParallelCopy_nowait(mf[dir],0,destcomp,numcomp);
+        } else {
+            FabSet& tmp = fs[face];
+            tmp.define(bndry[face].boxArray(),bndry[face].DistributionMap(),numcomp);
+            tmp.setVal(0);
+            tmp.multiFab().ParallelCopy_nowait(mf[dir],0,0,numcomp);
+        }
+    }
+
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const Orientation face = fi();
+        if (op == FluxRegister::COPY) {
+            bndry[face].multiFab().ParallelCopy_finish();
+        } else {
+            fs[face].multiFab().ParallelCopy_finish();
+        }
+    }
+
+    if (op == FluxRegister::ADD)
+    {
+#ifdef AMREX_USE_GPU
+        using Tag = Array4PairTag<Real>;
+        Vector<Tag> tags;
+        tags.reserve(mf[0].local_size()*AMREX_SPACEDIM*2);
+#endif
+
+        for (OrientationIter fi; fi; ++fi)
+        {
+            const Orientation face = fi();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (FabSetIter mfi(fs[face]); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+                auto const sfab = fs[face].const_array(mfi);
+                auto       dfab = bndry[face].array(mfi);
+#ifdef AMREX_USE_GPU
+                if (Gpu::inLaunchRegion()) {
+                    tags.push_back({dfab, sfab, bx});
+                } else
+#endif
+                {
+                    AMREX_LOOP_4D(bx, numcomp, i, j, k, n,
+                    {
+                        dfab(i,j,k,n+destcomp) += sfab(i,j,k,n);
+                    });
+                }
+            }
+        }
+
+#ifdef AMREX_USE_GPU
+        ParallelFor(tags, numcomp,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n, Tag const& tag) noexcept
+        {
+            tag.dfab(i,j,k,n+destcomp) += tag.sfab(i,j,k,n);
+        });
+#endif
+    }
+}
+
+void
+FluxRegister::CrseAdd (const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                       const Array<MultiFab const*,AMREX_SPACEDIM>& area,
+                       int             srccomp,
+                       int             destcomp,
+                       int             numcomp,
+                       Real            mult,
+                       const Geometry& geom)
+{
+    BL_PROFILE("FluxRegister::CrseAdd(batched)");
+    BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
+
+    Array<MultiFab,AMREX_SPACEDIM> mf;
+    scaleFluxes(mf, mflx, area, srccomp, numcomp, mult);
+
+    for (OrientationIter fi; fi; ++fi)
+    {
+        const Orientation face = fi();
+        bndry[face].multiFab().ParallelCopy_nowait(mf[face.coordDir()],0,destcomp,numcomp,
+                                                   geom.periodicity(),FabArrayBase::ADD);
+    }
+
+    for (OrientationIter fi; fi; ++fi)
+    {
+        bndry[fi()].multiFab().ParallelCopy_finish();
+    }
+}
+
+namespace {
+    struct FluxRegFineAddTag
+    {
+        Array4<Real> reg;
+        Array4<Real const> flx;
+        Array4<Real const> area;
+        Box dbox;
+        int dir;
+
+        [[nodiscard]] AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        Box const& box () const noexcept { return dbox; }
+    };
+
+    struct FluxRegRefluxTag
+    {
+        Array4<Real> dfab;
+        Array4<Real const> sfab;
+        Box dbox;
+        Real sign;
+
+        [[nodiscard]] AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        Box const& box () const noexcept { return dbox; }
+    };
+}
+
+void
+FluxRegister::FineAdd (const Array<MultiFab const*,AMREX_SPACEDIM>& mflx,
+                       const Array<MultiFab const*,AMREX_SPACEDIM>& area,
+                       int  srccomp,
+                       int  destcomp,
+                       int  numcomp,
+                       Real mult)
+{
+    BL_PROFILE("FluxRegister::FineAdd(batched)");
+    BL_ASSERT(destcomp >= 0 && destcomp+numcomp <= ncomp);
+
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion())
+    {
+        const Dim3 local_ratio = ratio.dim3();
+        Vector<FluxRegFineAddTag> tags;
+        tags.reserve(mflx[0]->local_size()*AMREX_SPACEDIM*2);
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+        {
+            BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx[dir]->nComp());
+            for (MFIter mfi(*mflx[dir]); mfi.isValid(); ++mfi)
+            {
+                const int k = mfi.index();
+                auto const farr = mflx[dir]->const_array(mfi);
+                auto const aarr = area[dir] ? area[dir]->const_array(mfi)
+                                            : Array4<Real const>{};
+                for (int s = 0; s < 2; ++s) {
+                    FArrayBox& reg = bndry[Orientation(dir,Orientation::Side(s))][k];
+                    tags.push_back({reg.array(), farr, aarr, reg.box(), dir});
+                }
+            }
+        }
+
+        ParallelFor(tags,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, FluxRegFineAddTag const& tag) noexcept
+        {
+            Box const b(IntVect(AMREX_D_DECL(i,j,k)),IntVect(AMREX_D_DECL(i,j,k)));
+            if (tag.area) {
+                fluxreg_fineareaadd(b, tag.reg, destcomp, tag.area, tag.flx, srccomp,
+                                    numcomp, tag.dir, local_ratio, mult);
+            } else {
+                fluxreg_fineadd(b, tag.reg, destcomp, tag.flx, srccomp,
+                                numcomp, tag.dir, local_ratio, mult);
+            }
+        });
+    }
+    else
+#endif
+    {
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
+        {
+            BL_ASSERT(srccomp >= 0 && srccomp+numcomp <= mflx[dir]->nComp());
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            for (MFIter mfi(*mflx[dir]); mfi.isValid(); ++mfi)
+            {
+                const int k = mfi.index();
+                if (area[dir]) {
+                    FineAdd((*mflx[dir])[mfi],(*area[dir])[mfi],dir,k,srccomp,destcomp,
+                            numcomp,mult,RunOn::Cpu);
+                } else {
+                    FineAdd((*mflx[dir])[mfi],dir,k,srccomp,destcomp,numcomp,mult,RunOn::Cpu);
+                }
+            }
+        }
+    }
+}
+
+void
+FluxRegister::BatchedReflux (MultiFab&       mf,
+                             Real            scale,
+                             int             scomp,
+                             int             dcomp,
+                             int             nc,
+                             const Geometry& geom,
+                             bool            mask_covered)
+{
+    const Real* dx = geom.CellSize();
+
+    MultiFab volume(mf.boxArray(), mf.DistributionMap(), 1, 0,
+                    MFInfo(), mf.Factory());
+
+    volume.setVal(AMREX_D_TERM(dx[0],*dx[1],*dx[2]), 0, 1, 0);
+
+    BatchedReflux(mf,volume,scale,scomp,dcomp,nc,geom,mask_covered);
+}
+
+void
+FluxRegister::BatchedReflux (MultiFab&       mf,
+                             const MultiFab& volume,
+                             Real            scale,
+                             int             scomp,
+                             int             dcomp,
+                             int             nc,
+                             const Geometry& geom,
+                             bool            mask_covered)
+{
+    BL_PROFILE("FluxRegister::BatchedReflux()");
+
+    constexpr int nfaces = 2*AMREX_SPACEDIM;
+    const int nboxes = static_cast<int>(grids.size());
+    Vector<Orientation> faces;
+    for (OrientationIter fi; fi; ++fi) {
+        faces.push_back(fi());
+    }
+
+    // The register of a low face is subtracted from the coarse cells just
+    // below it, and that of a high face is added to the cells just above
+    // it.  Box fi*nboxes+k of m_reflux_ba holds the cells for face fi of
+    // box k, and it is on the same process as the register.  They are
+    // kept so that the communication metadata can be reused.
+    if (m_reflux_ba.empty())
+    {
+        BoxList bl(IndexType::TheCellType());
+        bl.reserve(nfaces*nboxes);
+        Vector<int> pmap;
+        pmap.reserve(nfaces*nboxes);
+        for (auto const& face : faces) {
+            const BoxArray& fba = bndry[face].boxArray();
+            const auto& fpmap = bndry[face].DistributionMap().ProcessorMap();
+            for (int k = 0; k < nboxes; ++k) {
+                const Box fbx = fba[k];
+                Box b(fbx.smallEnd(), fbx.bigEnd());
+                if (face.isLow()) { b.shift(face.coordDir(), -1); }
+                bl.push_back(b);
+                pmap.push_back(fpmap[k]);
+            }
+        }
+        m_reflux_ba = BoxArray(std::move(bl));
+        m_reflux_dm = DistributionMapping(std::move(pmap));
+    }
+
+    MultiFab reg(m_reflux_ba, m_reflux_dm, nc, 0, MFInfo(), mf.Factory());
+
+#ifdef AMREX_USE_GPU
+    Vector<FluxRegRefluxTag> tags;
+    tags.reserve(reg.local_size());
+#endif
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(reg); mfi.isValid(); ++mfi)
+    {
+        const int ireg = mfi.index();
+        const Orientation face = faces[ireg / nboxes];
+        const Box& bx = mfi.validbox();
+        // Index the register by the coarse cells it is applied to.
+        FArrayBox const& rfab = bndry[face][ireg % nboxes];
+        Box cbox(rfab.box().smallEnd(), rfab.box().bigEnd());
+        if (face.isLow()) { cbox.shift(face.coordDir(), -1); }
+        auto const sfab = amrex::makeArray4<Real const>(rfab.dataPtr(scomp), cbox, nc);
+        auto const dfab = reg.array(mfi);
+        const Real sign = face.isLow() ? -1.0_rt : 1.0_rt;
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion()) {
+            tags.push_back({dfab, sfab, bx, sign});
+        } else
+#endif
+        {
+            AMREX_LOOP_4D(bx, nc, i, j, k, n,
+            {
+                dfab(i,j,k,n) = sign*sfab(i,j,k,n);
+            });
+        }
+    }
+
+#ifdef AMREX_USE_GPU
+    ParallelFor(tags, nc,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k, int n, FluxRegRefluxTag const& tag) noexcept
+    {
+        tag.dfab(i,j,k,n) = tag.sign*tag.sfab(i,j,k,n);
+    });
+#endif
+
+    MultiFab corr(mf.boxArray(), mf.DistributionMap(), nc, 0, MFInfo(), mf.Factory());
+    corr.setVal(0.0);
+    corr.ParallelAdd(reg, 0, 0, nc, 0, 0, geom.periodicity());
+
+    iMultiFab mask;
+    if (mask_covered) {
+        mask = amrex::makeFineMask(mf.boxArray(), mf.DistributionMap(), grids, IntVect(1));
+    }
+
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion() && mf.isFusingCandidate()) {
+        auto const& sma = mf.arrays();
+        auto const& cma = corr.const_arrays();
+        auto const& vma = volume.const_arrays();
+        if (mask_covered) {
+            auto const& mma = mask.const_arrays();
+            ParallelFor(mf, IntVect(0), nc,
+            [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k, int n) noexcept
+            {
+                if (!mma[box_no](i,j,k)) {
+                    sma[box_no](i,j,k,n+dcomp) += scale*cma[box_no](i,j,k,n)/vma[box_no](i,j,k);
+                }
+            });
+        } else {
+            ParallelFor(mf, IntVect(0), nc,
+            [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k, int n) noexcept
+            {
+                sma[box_no](i,j,k,n+dcomp) += scale*cma[box_no](i,j,k,n)/vma[box_no](i,j,k);
+            });
+        }
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& sfab = mf.array(mfi);
+            Array4<Real const> const& cfab = corr.const_array(mfi);
+            Array4<Real const> const& vfab = volume.const_array(mfi);
+            Array4<int const> mfab = mask_covered ? mask.const_array(mfi) : Array4<int const>{};
+            AMREX_HOST_DEVICE_PARALLEL_FOR_4D(bx, nc, i, j, k, n,
+            {
+                if (!mfab || !mfab(i,j,k)) {
+                    sfab(i,j,k,n+dcomp) += scale*cfab(i,j,k,n)/vfab(i,j,k);
+                }
+            });
+        }
+    }
+}
+
 void
 FluxRegister::ClearInternalBorders (const Geometry& geom)
 {
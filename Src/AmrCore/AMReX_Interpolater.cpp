@@ -23,6 +23,9 @@ namespace amrex {
  *
  * CellConservativeQuartic only works with ref ratio of 2 on cpu and gpu.
  *
+ * CellConservativeWENO5 and CellConservativeMP5 only work with ref ratio
+ * of 2 on cpu and gpu.
+ *
  * FaceConservativeLinear works in 2D and 3D on cpu and gpu.
  *
  * FaceDivFree works in 2D and 3D on cpu and gpu.
@@ -41,6 +44,8 @@ CellConservativeLinear    lincc_interp;
 CellConservativeLinear    cell_cons_interp(false);
 CellConservativeProtected protected_interp;
 CellConservativeQuartic   quartic_interp;
+CellConservativeWENO5     weno5_interp;
+CellConservativeMP5       mp5_interp;
 CellBilinear              cell_bilinear_interp;
 CellQuadratic             quadratic_interp;
 CellQuartic               cell_quartic_interp;
@@ -1230,6 +1235,110 @@ CellConservativeQuartic::interp (const FArrayBox&  crse,
     });
 }
 
+Box
+CellConservativeWENO5::CoarseBox (const Box& fine,
+                                  int        ratio)
+{
+    Box crse(amrex::coarsen(fine,ratio));
+    crse.grow(2);
+    return crse;
+}
+
+Box
+CellConservativeWENO5::CoarseBox (const Box&     fine,
+                                  const IntVect& ratio)
+{
+    Box crse = amrex::coarsen(fine,ratio);
+    crse.grow(2);
+    return crse;
+}
+
+void
+CellConservativeWENO5::interp (const FArrayBox&  crse,
+                               int               crse_comp,
+                               FArrayBox&        fine,
+                               int               fine_comp,
+                               int               ncomp,
+                               const Box&        fine_region,
+                               const IntVect&    ratio,
+                               const Geometry&   /* crse_geom */,
+                               const Geometry&   /* fine_geom */,
+                               Vector<BCRec> const& /*bcr*/,
+                               int               /* actual_comp */,
+                               int               /* actual_state */,
+                               RunOn             runon)
+{
+    BL_PROFILE("CellConservativeWENO5::interp()");
+    AMREX_ASSERT(ratio == 2);
+    amrex::ignore_unused(ratio);
+
+    //
+    // Make box which is intersection of fine_region and domain of fine.
+    //
+    Box target_fine_region = fine_region & fine.box();
+
+    // Extract pointers to fab data
+    Array4<Real const> const& crsearr = crse.const_array(crse_comp);
+    Array4<Real>       const& finearr = fine.array(fine_comp);
+
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, target_fine_region, ncomp, i, j, k, n,
+    {
+        cc_5pt_interp(i, j, k, n, crsearr, finearr, CellWENO5LowerHalf{});
+    });
+}
+
+Box
+CellConservativeMP5::CoarseBox (const Box& fine,
+                                int        ratio)
+{
+    Box crse(amrex::coarsen(fine,ratio));
+    crse.grow(2);
+    return crse;
+}
+
+Box
+CellConservativeMP5::CoarseBox (const Box&     fine,
+                                const IntVect& ratio)
+{
+    Box crse = amrex::coarsen(fine,ratio);
+    crse.grow(2);
+    return crse;
+}
+
+void
+CellConservativeMP5::interp (const FArrayBox&  crse,
+                             int               crse_comp,
+                             FArrayBox&        fine,
+                             int               fine_comp,
+                             int               ncomp,
+                             const Box&        fine_region,
+                             const IntVect&    ratio,
+                             const Geometry&   /* crse_geom */,
+                             const Geometry&   /* fine_geom */,
+                             Vector<BCRec> const& /*bcr*/,
+                             int               /* actual_comp */,
+                             int               /* actual_state */,
+                             RunOn             runon)
+{
+    BL_PROFILE("CellConservativeMP5::interp()");
+    AMREX_ASSERT(ratio == 2);
+    amrex::ignore_unused(ratio);
+
+    //
+    // Make box which is intersection of fine_region and domain of fine.
+    //
+    Box target_fine_region = fine_region & fine.box();
+
+    // Extract pointers to fab data
+    Array4<Real const> const& crsearr = crse.const_array(crse_comp);
+    Array4<Real>       const& finearr = fine.array(fine_comp);
+
+    AMREX_HOST_DEVICE_PARALLEL_FOR_4D_FLAG(runon, target_fine_region, ncomp, i, j, k, n,
+    {
+        cc_5pt_interp(i, j, k, n, crsearr, finearr, CellMP5LowerHalf{});
+    });
+}
+
 Box
 FaceDivFree::CoarseBox (const Box& fine,
                         int        ratio)
@@ -12,6 +12,8 @@ MFCellConsLinInterp mf_cell_cons_interp(false);
 MFCellConsLinInterp mf_lincc_interp(true);
 MFCellConsLinMinmaxLimitInterp mf_linear_slope_minmax_interp;
 MFCellBilinear      mf_cell_bilinear_interp;
+MFCellConsWENO5Interp mf_weno5_interp;
+MFCellConsMP5Interp mf_mp5_interp;
 
 // Nodal
 MFNodeBilinear      mf_node_bilinear_interp;
@@ -477,6 +479,92 @@ MFCellBilinear::interp (MultiFab const& crsemf, int ccomp, MultiFab& finemf, int
     }
 }
 
+namespace {
+    template <typename F>
+    void mf_cc_5pt_interp (MultiFab const& crsemf, int ccomp, MultiFab& finemf, int fcomp,
+                           int nc, IntVect const& ng, Box const& dest_domain,
+                           IntVect const& ratio, F const& lower_half)
+    {
+        AMREX_ALWAYS_ASSERT(ratio == 2);
+        amrex::ignore_unused(ratio);
+
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion()) {
+            auto const& crse = crsemf.const_arrays();
+            auto const& fine = finemf.arrays();
+            ParallelFor(finemf, ng, nc,
+            [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k, int n) noexcept
+            {
+                if (dest_domain.contains(i,j,k)) {
+                    cc_5pt_interp(i,j,k,n, Array4<Real const>(crse[box_no],ccomp,nc),
+                                  Array4<Real>(fine[box_no],fcomp,nc), lower_half);
+                }
+            });
+            Gpu::streamSynchronize();
+        } else
+#endif
+        {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            for (MFIter mfi(finemf); mfi.isValid(); ++mfi) {
+                Array4<Real> const fine(finemf.array(mfi), fcomp, nc);
+                Array4<Real const> const crse(crsemf.const_array(mfi), ccomp, nc);
+                Box const& fbox = amrex::grow(mfi.validbox(),ng) & dest_domain;
+                amrex::LoopConcurrentOnCpu(fbox, nc,
+                [=] (int i, int j, int k, int n) noexcept
+                {
+                    cc_5pt_interp(i,j,k,n, crse, fine, lower_half);
+                });
+            }
+        }
+    }
+}
+
+Box
+MFCellConsWENO5Interp::CoarseBox (const Box& fine, const IntVect& ratio)
+{
+    return amrex::coarsen(fine,ratio).grow(2);
+}
+
+Box
+MFCellConsWENO5Interp::CoarseBox (const Box& fine, int ratio)
+{
+    return amrex::coarsen(fine,ratio).grow(2);
+}
+
+void
+MFCellConsWENO5Interp::interp (MultiFab const& crsemf, int ccomp, MultiFab& finemf, int fcomp, int nc,
+                               IntVect const& ng, Geometry const&, Geometry const&,
+                               Box const& dest_domain, IntVect const& ratio,
+                               Vector<BCRec> const&, int)
+{
+    mf_cc_5pt_interp(crsemf, ccomp, finemf, fcomp, nc, ng, dest_domain, ratio,
+                     CellWENO5LowerHalf{});
+}
+
+Box
+MFCellConsMP5Interp::CoarseBox (const Box& fine, const IntVect& ratio)
+{
+    return amrex::coarsen(fine,ratio).grow(2);
+}
+
+Box
+MFCellConsMP5Interp::CoarseBox (const Box& fine, int ratio)
+{
+    return amrex::coarsen(fine,ratio).grow(2);
+}
+
+void
+MFCellConsMP5Interp::interp (MultiFab const& crsemf, int ccomp, MultiFab& finemf, int fcomp, int nc,
+                             IntVect const& ng, Geometry const&, Geometry const&,
+                             Box const& dest_domain, IntVect const& ratio,
+                             Vector<BCRec> const&, int)
+{
+    mf_cc_5pt_interp(crsemf, ccomp, finemf, fcomp, nc, ng, dest_domain, ratio,
+                     CellMP5LowerHalf{});
+}
+
 Box
 MFNodeBilinear::CoarseBox (const Box& fine, const IntVect& ratio)
 {
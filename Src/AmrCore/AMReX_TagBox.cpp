@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <climits>
+#include <cstdint>
 
 namespace amrex {
 
@@ -75,48 +76,87 @@ TagBox::coarsen (const IntVect& ratio, const Box& cbox) noexcept
 void
 TagBox::buffer (const IntVect& a_nbuff, const IntVect& a_nwid) noexcept
 {
+    if (a_nbuff.max() <= 0) { return; }
+
+    // The SET cells in the interior are packed into a bitmask with 64
+    // cells in x per word.  The dilation is separable, so we dilate the
+    // mask in x with shifts, and then in y and z by or'ing whole words.
+    // The cost is O(ncells*nbuf/64) instead of O(ncells*nbuf^3).
     Box const& interior = amrex::grow(domain, -a_nwid);
     Dim3 nbuf = a_nbuff.dim3();
+    const auto lo = amrex::lbound(domain);
+    const auto hi = amrex::ubound(domain);
+    const auto ilo = amrex::lbound(interior);
+    const auto ihi = amrex::ubound(interior);
+    const int nwords = (hi.x-lo.x+64)/64;
+
+    using Word = std::uint64_t;
+    Box const wbox(IntVect(AMREX_D_DECL(0        , lo.y, lo.z)),
+                   IntVect(AMREX_D_DECL(nwords-1 , hi.y, hi.z)));
+    BaseFab<Word> m0(wbox, 1, The_Async_Arena());
+    BaseFab<Word> m1(wbox, 1, The_Async_Arena());
+    Array4<Word> const& b0 = m0.array();
+    Array4<Word> const& b1 = m1.array();
     Array4<char> const& a = this->array();
-#ifdef AMREX_USE_GPU
-    if (Gpu::inLaunchRegion()) {
-        Box const& interiorplusbuf = amrex::grow(interior, a_nbuff);
-        const auto lo = amrex::lbound(interiorplusbuf);
-        const auto hi = amrex::ubound(interiorplusbuf);
-        AMREX_HOST_DEVICE_FOR_3D(interiorplusbuf, i, j, k,
-        {
-            if (a(i,j,k) == TagBox::CLEAR) {
-                bool to_buf = false;
-                int imin = amrex::max(i-nbuf.x, lo.x);
-                int jmin = amrex::max(j-nbuf.y, lo.y);
-                int kmin = amrex::max(k-nbuf.z, lo.z);
-                int imax = amrex::min(i+nbuf.x, hi.x);
-                int jmax = amrex::min(j+nbuf.y, hi.y);
-                int kmax = amrex::min(k+nbuf.z, hi.z);
-                // xxxxx TODO: If nbuf is large, this is not efficient.
-                //             We need to find another better way.
-                for (int kk = kmin; kk <= kmax && !to_buf; ++kk) {
-                for (int jj = jmin; jj <= jmax && !to_buf; ++jj) {
-                for (int ii = imin; ii <= imax && !to_buf; ++ii) {
-                    if (a(ii,jj,kk) == TagBox::SET) { to_buf = true; }
-                }}}
-                if (to_buf) { a(i,j,k) = TagBox::BUF; }
+
+    amrex::ParallelFor(wbox, [=] AMREX_GPU_HOST_DEVICE (int w, int j, int k) noexcept
+    {
+        Word m = 0;
+        if (j >= ilo.y && j <= ihi.y && k >= ilo.z && k <= ihi.z) {
+            const int i0 = lo.x + 64*w;
+            const int ib = amrex::max(i0, ilo.x);
+            const int ie = amrex::min(i0+63, ihi.x);
+            for (int i = ib; i <= ie; ++i) {
+                if (a(i,j,k) == TagBox::SET) { m |= Word(1) << (i-i0); }
             }
-        });
-    } else
-#endif
+        }
+        b0(w,j,k) = m;
+    });
+
+    amrex::ParallelFor(wbox, [=] AMREX_GPU_HOST_DEVICE (int w, int j, int k) noexcept
     {
-        AMREX_LOOP_3D(interior, i, j, k,
+        // Bits of the row shifted by s cells, i.e., bit b of the result
+        // is cell b-s of the source.
+        auto shifted = [&] (int s) -> Word
         {
-            if (a(i,j,k) == TagBox::SET) {
-                for (int kk = k-nbuf.z; kk <= k+nbuf.z; ++kk) {
-                for (int jj = j-nbuf.y; jj <= j+nbuf.y; ++jj) {
-                for (int ii = i-nbuf.x; ii <= i+nbuf.x; ++ii) {
-                    if (a(ii,jj,kk) == TagBox::CLEAR) { a(ii,jj,kk) = TagBox::BUF; }
-                }}}
-            }
-        });
-    }
+            const int p = 64*w - s;
+            const int lw = (p >= 0) ? p/64 : -((-p+63)/64);
+            const int sh = p - 64*lw;
+            Word r = 0;
+            if (lw >= 0 && lw < nwords) { r = b0(lw,j,k) >> sh; }
+            if (sh > 0 && lw+1 >= 0 && lw+1 < nwords) { r |= b0(lw+1,j,k) << (64-sh); }
+            return r;
+        };
+        Word m = 0;
+        for (int s = -nbuf.x; s <= nbuf.x; ++s) { m |= shifted(s); }
+        b1(w,j,k) = m;
+    });
+
+    amrex::ParallelFor(wbox, [=] AMREX_GPU_HOST_DEVICE (int w, int j, int k) noexcept
+    {
+        Word m = 0;
+        for (int jj = amrex::max(j-nbuf.y,lo.y); jj <= amrex::min(j+nbuf.y,hi.y); ++jj) {
+            m |= b1(w,jj,k);
+        }
+        b0(w,j,k) = m;
+    });
+
+    amrex::ParallelFor(wbox, [=] AMREX_GPU_HOST_DEVICE (int w, int j, int k) noexcept
+    {
+        Word m = 0;
+        for (int kk = amrex::max(k-nbuf.z,lo.z); kk <= amrex::min(k+nbuf.z,hi.z); ++kk) {
+            m |= b0(w,j,kk);
+        }
+        b1(w,j,k) = m;
+    });
+
+    amrex::ParallelFor(domain, [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) noexcept
+    {
+        const int ii = i - lo.x;
+        if (a(i,j,k) == TagBox::CLEAR && ((b1(ii/64,j,k) >> (ii%64)) & Word(1))) {
+            a(i,j,k) = TagBox::BUF;
+        }
+    });
 }
 
 // DEPRECATED
@@ -589,19 +629,87 @@ TagBoxArray::local_collate_gpu (Gpu::PinnedVector<IntVect>& v) const
 #endif
 
 void
-TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+TagBoxArray::local_collate (Gpu::PinnedVector<IntVect>& v) const
 {
-    BL_PROFILE("TagBoxArray::collate()");
+    BL_PROFILE("TagBoxArray::local_collate()");
 
-    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
-        local_collate_gpu(TheLocalCollateSpace);
+        local_collate_gpu(v);
     } else
 #endif
     {
-        local_collate_cpu(TheLocalCollateSpace);
+        local_collate_cpu(v);
+    }
+}
+
+namespace {
+
+// Tags come in long runs in x.  We send (start, length) pairs instead of
+// every IntVect, which reduces the size of the gather by roughly the
+// average run length.
+void encode_tag_runs (Gpu::PinnedVector<IntVect>& tags, Vector<int>& runs)
+{
+    runs.clear();
+    if (tags.empty()) { return; }
+
+#ifdef AMREX_USE_GPU
+    // The GPU version of local_collate does not preserve the cell order
+    // within a block.
+    std::sort(tags.begin(), tags.end(), [] (IntVect const& a, IntVect const& b)
+    {
+        for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+            if (a[idim] != b[idim]) { return a[idim] < b[idim]; }
+        }
+        return false;
+    });
+#endif
+
+    IntVect start = tags[0];
+    int len = 1;
+    auto flush = [&] () {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            runs.push_back(start[idim]);
+        }
+        runs.push_back(len);
+    };
+    for (std::size_t n = 1, N = tags.size(); n < N; ++n) {
+        IntVect next = start;
+        next[0] += len;
+        if (tags[n] == next) {
+            ++len;
+        } else {
+            flush();
+            start = tags[n];
+            len = 1;
+        }
     }
+    flush();
+}
+
+void decode_tag_runs (int const* runs, Long nruns, IntVect* tags)
+{
+    constexpr int nints = AMREX_SPACEDIM+1;
+    for (Long r = 0; r < nruns; ++r) {
+        int const* p = runs + r*nints;
+        IntVect iv(AMREX_D_DECL(p[0],p[1],p[2]));
+        const int len = p[AMREX_SPACEDIM];
+        for (int n = 0; n < len; ++n) {
+            *tags++ = iv;
+            ++iv[0];
+        }
+    }
+}
+
+}
+
+void
+TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate()");
+
+    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
+    local_collate(TheLocalCollateSpace);
 
     Long count = static_cast<Long>(TheLocalCollateSpace.size());
 
@@ -614,58 +722,61 @@ TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
     if (numtags == 0) {
         TheGlobalCollateSpace.clear();
         return;
-    } else if (numtags > static_cast<Long>(std::numeric_limits<int>::max())) {
-        // xxxxx todo
-        amrex::Abort("TagBoxArray::collate: Too many tags. Using a larger blocking factor might help. Please file an issue on github");
     }
 
 #ifdef BL_USE_MPI
     //
-    // On I/O proc. this holds all tags after they've been gather'd.
-    // On other procs. non-mempty signals size is not zero.
+    // Run-length encode the local tags.  The encoded runs are exchanged as
+    // plain integers, which also avoids issues with MPI_Datatype that have
+    // been observed at very large scale with FujitsuMPI.
     //
-    if (ParallelDescriptor::IOProcessor()) {
-        TheGlobalCollateSpace.resize(numtags);
-    } else {
-        TheGlobalCollateSpace.resize(1);
+    Vector<int> runs;
+    encode_tag_runs(TheLocalCollateSpace, runs);
+    TheLocalCollateSpace.clear();
+
+    Long nints = static_cast<Long>(runs.size());
+    Long nints_total = nints;
+    ParallelDescriptor::ReduceLongSum(nints_total);
+    if (nints_total > static_cast<Long>(std::numeric_limits<int>::max())) {
+        // xxxxx todo
+        amrex::Abort("TagBoxArray::collate: Too many tags. Using a larger blocking factor might help. Please file an issue on github");
     }
 
     //
-    // Tell root CPU how many tags each CPU will be sending.
+    // Tell root CPU how many integers each CPU will be sending.
     //
     const int IOProcNumber = ParallelDescriptor::IOProcessorNumber();
-    const std::vector<int>& countvec = ParallelDescriptor::Gather(static_cast<int>(count),
+    const std::vector<int>& countvec = ParallelDescriptor::Gather(static_cast<int>(nints),
                                                                   IOProcNumber);
     std::vector<int> offset(countvec.size(),0);
+    Vector<int> allruns;
     if (ParallelDescriptor::IOProcessor()) {
         for (std::size_t i = 1, N = offset.size(); i < N; i++) {
             offset[i] = offset[i-1] + countvec[i-1];
         }
+        allruns.resize(nints_total);
+    } else {
+        allruns.resize(1);
     }
     //
-    // Gather all the tags to IOProcNumber into TheGlobalCollateSpace.
+    // Gather all the runs to IOProcNumber and expand them into
+    // TheGlobalCollateSpace.
     //
-    const IntVect* psend = (count > 0) ? TheLocalCollateSpace.data() : nullptr;
-    IntVect* precv = TheGlobalCollateSpace.data();
-
-    // Issues have been observed with the following call at very large scale when using
-    // FujitsuMPI. The issue seems to be related to the use of MPI_Datatype. We can
-    // bypasses the issue by exchanging simpler integer arrays.
-#if !(defined(__FUJITSU) || defined(__CLANG_FUJITSU))
-    ParallelDescriptor::Gatherv(psend, static_cast<int>(count), precv, countvec, offset, IOProcNumber);
-#else
-    const int* psend_int = psend->begin();
-    int* precv_int = precv->begin();
-    Long count_int = count * AMREX_SPACEDIM;
-    auto countvec_int = std::vector<int>(countvec.size());
-    auto offset_int = std::vector<int>(offset.size());
-    const auto mul_funct = [](const auto el){return el*AMREX_SPACEDIM;};
-    std::transform(countvec.begin(), countvec.end(), countvec_int.begin(), mul_funct);
-    std::transform(offset.begin(), offset.end(), offset_int.begin(), mul_funct);
-    ParallelDescriptor::Gatherv(
-        psend_int, count_int, precv_int, countvec_int, offset_int, IOProcNumber);
-#endif
+    const int* psend = (nints > 0) ? runs.data() : nullptr;
+    ParallelDescriptor::Gatherv(psend, static_cast<int>(nints), allruns.data(), countvec, offset,
+                                IOProcNumber);
 
+    //
+    // On I/O proc. this holds all tags after they've been gather'd.
+    // On other procs. non-mempty signals size is not zero.
+    //
+    if (ParallelDescriptor::IOProcessor()) {
+        TheGlobalCollateSpace.resize(numtags);
+        decode_tag_runs(allruns.data(), nints_total/(AMREX_SPACEDIM+1),
+                        TheGlobalCollateSpace.data());
+    } else {
+        TheGlobalCollateSpace.resize(1);
+    }
 #else
     TheGlobalCollateSpace = std::move(TheLocalCollateSpace);
 #endif
@@ -1220,13 +1220,21 @@ BoxArray::intersections (const Box&                         bx,
                          std::vector< std::pair<int,Box> >& isects,
                          bool                               first_only,
                          const IntVect&                     ng) const
+{
+    isects.resize(0);
+    appendIntersections(bx, isects, first_only, ng);
+}
+
+void
+BoxArray::appendIntersections (const Box&                         bx,
+                               std::vector< std::pair<int,Box> >& isects,
+                               bool                               first_only,
+                               const IntVect&                     ng) const
 {
     // This is called too many times BL_PROFILE("BoxArray::intersections()");
 
     BARef::HashType& BoxHashMap = getHashMap();
 
-    isects.resize(0);
-
     if (!BoxHashMap.empty())
     {
         BL_ASSERT(bx.ixType() == ixType());
@@ -1303,6 +1311,66 @@ BoxArray::intersections (const Box&                         bx,
     }
 }
 
+void
+BoxArray::intersections (const Vector<Box>& bxs, Vector<std::pair<int,Box> >& isects,
+                         Vector<int>& offsets, const IntVect& ng) const
+{
+    BL_PROFILE("BoxArray::intersections(batched)");
+
+    const int N = static_cast<int>(bxs.size());
+    offsets.resize(N+1);
+    offsets[0] = 0;
+    isects.clear();
+    if (N == 0) { return; }
+
+    // Build the hash before the parallel region.
+    amrex::ignore_unused(getHashMap());
+
+    const int nthreads = (N > 64 && !OpenMP::in_parallel()) ? OpenMP::get_max_threads() : 1;
+
+    if (nthreads == 1) {
+        for (int i = 0; i < N; ++i) {
+            appendIntersections(bxs[i], isects, false, ng);
+            offsets[i+1] = static_cast<int>(isects.size());
+        }
+        return;
+    }
+
+    // The queries are split into contiguous chunks so that the results can
+    // be concatenated in order.  The chunks are distributed with a loop so
+    // that the result does not depend on the size of the team we actually get.
+    const int nchunks = nthreads;
+    Vector<std::vector<std::pair<int,Box> > > tisects(nchunks);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+    for (int ichunk = 0; ichunk < nchunks; ++ichunk) {
+        const int ibegin = static_cast<int>((Long(N)*ichunk)/nchunks);
+        const int iend = static_cast<int>((Long(N)*(ichunk+1))/nchunks);
+        auto& tis = tisects[ichunk];
+        for (int i = ibegin; i < iend; ++i) {
+            appendIntersections(bxs[i], tis, false, ng);
+            offsets[i+1] = static_cast<int>(tis.size());
+        }
+    }
+
+    int offset = 0;
+    for (int ichunk = 0; ichunk < nchunks; ++ichunk) {
+        const int ibegin = static_cast<int>((Long(N)*ichunk)/nchunks);
+        const int iend = static_cast<int>((Long(N)*(ichunk+1))/nchunks);
+        for (int i = ibegin; i < iend; ++i) {
+            offsets[i+1] += offset;
+        }
+        offset += static_cast<int>(tisects[ichunk].size());
+    }
+
+    isects.reserve(offset);
+    for (auto const& tis : tisects) {
+        isects.insert(isects.end(), tis.begin(), tis.end());
+    }
+}
+
 BoxList
 BoxArray::complementIn (const Box& bx) const
 {
@@ -1523,6 +1591,43 @@ BoxArray::getDoiHi () const noexcept
     return m_bat.doiHi();
 }
 
+namespace {
+    // Sort with OpenMP: each thread sorts a chunk, then the chunks are
+    // merged pairwise.
+    void sort_bin_keys (Vector<std::pair<Long,int> >& keys)
+    {
+        const int N = static_cast<int>(keys.size());
+        int nchunks = 1;
+#ifdef AMREX_USE_OMP
+        if (N > 10000 && !OpenMP::in_parallel()) { nchunks = OpenMP::get_max_threads(); }
+#endif
+        if (nchunks == 1) {
+            std::sort(keys.begin(), keys.end());
+            return;
+        }
+
+        auto chunk_begin = [=] (int ichunk) { return static_cast<int>((Long(N)*ichunk)/nchunks); };
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+        for (int ichunk = 0; ichunk < nchunks; ++ichunk) {
+            std::sort(keys.begin()+chunk_begin(ichunk), keys.begin()+chunk_begin(ichunk+1));
+        }
+
+        for (int stride = 1; stride < nchunks; stride *= 2) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+            for (int ichunk = 0; ichunk < nchunks-stride; ichunk += 2*stride) {
+                std::inplace_merge(keys.begin()+chunk_begin(ichunk),
+                                   keys.begin()+chunk_begin(ichunk+stride),
+                                   keys.begin()+chunk_begin(std::min(ichunk+2*stride,nchunks)));
+            }
+        }
+    }
+}
+
 BARef::HashType&
 BoxArray::getHashMap () const
 {
@@ -1536,30 +1641,87 @@ BoxArray::getHashMap () const
     {
         if (BoxHashMap.empty() && size() > 0)
         {
+            auto const& abox = m_ref->m_abox;
+            const int N = static_cast<int>(size());
+
             //
             // Calculate the bounding box & maximum extent of the boxes.
             //
             IntVect maxext = IntVect::TheUnitVector();
-            Box boundingbox = m_ref->m_abox[0];
+            IntVect bblo = abox[0].smallEnd();
+            IntVect bbhi = abox[0].bigEnd();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (N > 1000)
+#endif
+            {
+                IntVect tmaxext = maxext;
+                IntVect tlo = bblo;
+                IntVect thi = bbhi;
+#ifdef AMREX_USE_OMP
+#pragma omp for nowait
+#endif
+                for (int i = 0; i < N; ++i)
+                {
+                    Box bx = abox[i];
+                    bx.normalize();
+                    tmaxext.max(bx.size());
+                    tlo.min(bx.smallEnd());
+                    thi.max(bx.bigEnd());
+                }
+#ifdef AMREX_USE_OMP
+#pragma omp critical(getHashMap_bbox)
+#endif
+                {
+                    maxext.max(tmaxext);
+                    bblo.min(tlo);
+                    bbhi.max(thi);
+                }
+            }
 
-            const int N = static_cast<int>(size());
+            Box boundingbox(bblo, bbhi);
+            boundingbox.coarsen(maxext);
+
+            //
+            // Sort the boxes by their bins.  The boxes in a bin stay in
+            // the order of their indices, so the intersections come out
+            // in the same order as with a bin-by-bin insertion.
+            //
+            const IntVect bin_lo = boundingbox.smallEnd();
+            const IntVect bin_len = boundingbox.length();
+            Vector<std::pair<Long,int> > keys(N);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for if (N > 1000)
+#endif
             for (int i = 0; i < N; ++i)
             {
-                Box bx = m_ref->m_abox[i];
-                bx.normalize();
-                maxext = amrex::max(maxext, bx.size());
-                boundingbox.minBox(bx);
+                const IntVect iv = amrex::coarsen(abox[i].smallEnd(),maxext) - bin_lo;
+                Long key = 0;
+                for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+                    key = key*bin_len[idim] + iv[idim];
+                }
+                keys[i] = std::make_pair(key,i);
             }
+            sort_bin_keys(keys);
 
-            for (int i = 0; i < N; i++)
+            //
+            // Insert one bin at a time.
+            //
+            BoxHashMap.reserve(N);
+            for (int ibegin = 0; ibegin < N; )
             {
-                const IntVect& crsnsmlend
-                    = amrex::coarsen(m_ref->m_abox[i].smallEnd(),maxext);
-                BoxHashMap[crsnsmlend].push_back(i);
+                int iend = ibegin+1;
+                while (iend < N && keys[iend].first == keys[ibegin].first) { ++iend; }
+                auto& bin = BoxHashMap[amrex::coarsen(abox[keys[ibegin].second].smallEnd(),
+                                                      maxext)];
+                bin.reserve(iend-ibegin);
+                for (int i = ibegin; i < iend; ++i) {
+                    bin.push_back(keys[i].second);
+                }
+                ibegin = iend;
             }
 
             m_ref->crsn = maxext;
-            m_ref->bbox = boundingbox.coarsen(maxext);
+            m_ref->bbox = boundingbox;
             m_ref->bbox.normalize();
 
 #ifdef AMREX_MEM_PROFILING
@@ -1719,23 +1881,28 @@ BoxArray
 intersect (const BoxArray& lhs, const BoxArray& rhs)
 {
     if (lhs.empty() || rhs.empty()) { return BoxArray(); }
+    const BoxList& lbl = lhs.boxList();
+    Vector<std::pair<int,Box> > isects;
+    Vector<int> offsets;
+    rhs.intersections(lbl.data(), isects, offsets);
     BoxList bl(lhs[0].ixType());
-    for (int i = 0, Nl = static_cast<int>(lhs.size()); i < Nl; ++i)
-    {
-        const BoxArray& ba = amrex::intersect(rhs, lhs[i]);
-        bl.join(ba.boxList());
+    bl.reserve(isects.size());
+    for (auto const& is : isects) {
+        bl.push_back(is.second);
     }
-    return BoxArray(bl);
+    return BoxArray(std::move(bl));
 }
 
 BoxList
 intersect (const BoxArray& ba, const BoxList& bl)
 {
+    Vector<std::pair<int,Box> > isects;
+    Vector<int> offsets;
+    ba.intersections(bl.data(), isects, offsets);
     BoxList newbl(bl.ixType());
-    for (const Box& bx : bl)
-    {
-        const BoxArray& newba = amrex::intersect(ba, bx);
-        newbl.join(newba.boxList());
+    newbl.reserve(isects.size());
+    for (auto const& is : isects) {
+        newbl.push_back(is.second);
     }
     return newbl;
 }
@@ -1920,6 +1920,57 @@ DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol, int nprocs)
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeIncremental (const BoxArray& ba, const BoxArray& old_ba,
+                                      const DistributionMapping& old_dm)
+{
+    BL_PROFILE("makeIncremental");
+
+    AMREX_ASSERT(old_ba.size() == old_dm.size());
+
+    const int N = static_cast<int>(ba.size());
+    const int nprocs = ParallelContext::NProcsSub();
+
+    std::map<Box,int> old_boxes;
+    for (int i = 0, M = static_cast<int>(old_ba.size()); i < M; ++i) {
+        old_boxes.emplace(old_ba[i], old_dm[i]);
+    }
+
+    Vector<int> pmap(N, -1);
+    std::vector<Long> load(nprocs, 0);
+    std::vector<int> unassigned;
+    for (int i = 0; i < N; ++i) {
+        const Box& bx = ba[i];
+        auto it = old_boxes.find(bx);
+        // The old owner may not be part of the current sub-communicator.
+        const int local_rank = (it != old_boxes.end())
+            ? ParallelContext::global_to_local_rank(it->second) : -1;
+        if (local_rank >= 0) {
+            pmap[i] = it->second;
+            load[local_rank] += bx.numPts();
+        } else {
+            unassigned.push_back(i);
+        }
+    }
+
+    std::stable_sort(unassigned.begin(), unassigned.end(), [&ba] (int i, int j)
+                     { return ba[i].numPts() > ba[j].numPts(); });
+
+    using LoadRank = std::pair<Long,int>;
+    std::priority_queue<LoadRank, std::vector<LoadRank>, std::greater<>> pq;
+    for (int rank = 0; rank < nprocs; ++rank) {
+        pq.emplace(load[rank], rank);
+    }
+    for (int i : unassigned) {
+        auto [l, rank] = pq.top();
+        pq.pop();
+        pmap[i] = ParallelContext::local_to_global_rank(rank);
+        pq.emplace(l + ba[i].numPts(), rank);
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
+
 const Vector<int>&
 DistributionMapping::getIndexArray ()
 {
@@ -23,11 +23,19 @@
 #endif
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <type_traits>
 #include <utility>
 
 namespace amrex {
 
 int FabArrayBase::MaxComp = 25;
+std::string FabArrayBase::comm_metadata_dir;
+int FabArrayBase::comm_metadata_max_files = 16;
 
 #if defined(AMREX_USE_GPU)
 
@@ -124,6 +132,9 @@ FabArrayBase::Initialize ()
 
     pp.query("maxcomp", FabArrayBase::MaxComp);
 
+    pp.query("comm_metadata_dir", FabArrayBase::comm_metadata_dir);
+    pp.query("comm_metadata_max_files", FabArrayBase::comm_metadata_max_files);
+
     if (MaxComp < 1) {
         MaxComp = 1;
     }
@@ -284,6 +295,232 @@ FabArrayBase::TileArray::bytes () const
         + (amrex::bytesOf(this->tileArray)         - sizeof(this->tileArray));
 }
 
+namespace {
+
+    // The intersections of a BoxArray with a sequence of boxes, each shifted
+    // by a number of periodic shifts.  They are computed in parallel a chunk
+    // of boxes at a time, which bounds the memory used.  The boxes must be
+    // visited in increasing order.
+    class BatchedIntersections
+    {
+    public:
+        using Isect = std::pair<int,Box>;
+
+        struct Range
+        {
+            Isect const* m_begin;
+            Isect const* m_end;
+            [[nodiscard]] Isect const* begin () const noexcept { return m_begin; }
+            [[nodiscard]] Isect const* end () const noexcept { return m_end; }
+        };
+
+        BatchedIntersections (BoxArray const& ba, IntVect const& ng, int nboxes,
+                              std::function<Box(int)> box, std::vector<IntVect> const& shifts)
+            : m_ba(ba), m_ng(ng), m_nboxes(nboxes), m_box(std::move(box)), m_shifts(shifts),
+              m_chunk(std::max(1, std::max(1024, 64*OpenMP::get_max_threads())
+                                  / static_cast<int>(shifts.size())))
+        {}
+
+        //! Intersections of box i shifted by shifts[j]
+        Range operator() (int i, int j)
+        {
+            AMREX_ASSERT(i >= m_begin && i < m_nboxes);
+            const int nshifts = static_cast<int>(m_shifts.size());
+            if (i >= m_end) {
+                m_begin = i;
+                m_end = std::min(i+m_chunk, m_nboxes);
+                m_qbxs.resize(std::size_t(m_end-m_begin)*nshifts);
+                for (int ii = m_begin; ii < m_end; ++ii) {
+                    const Box& bx = m_box(ii);
+                    for (int jj = 0; jj < nshifts; ++jj) {
+                        m_qbxs[(ii-m_begin)*nshifts+jj] = bx + m_shifts[jj];
+                    }
+                }
+                m_ba.intersections(m_qbxs, m_isects, m_offsets, m_ng);
+            }
+            const int q = (i-m_begin)*nshifts + j;
+            return Range{m_isects.data()+m_offsets[q], m_isects.data()+m_offsets[q+1]};
+        }
+
+    private:
+        BoxArray const& m_ba;
+        IntVect m_ng;
+        int m_nboxes;
+        std::function<Box(int)> m_box;
+        std::vector<IntVect> const& m_shifts;
+        int m_chunk;
+        int m_begin = 0;
+        int m_end = 0;
+        Vector<Box> m_qbxs;
+        Vector<Isect> m_isects;
+        Vector<int> m_offsets;
+    };
+
+    // Hash of everything that determines the communication metadata of a
+    // process.  Two independent 64-bit hashes and the number of bytes hashed
+    // are stored in the file and compared when it is read.
+    struct CommMetaDataKey
+    {
+        std::uint64_t h1 = 14695981039346656037ULL;
+        std::uint64_t h2 = 0x9e3779b97f4a7c15ULL;
+        Long nbytes = 0;
+
+        void add (void const* p, std::size_t n) {
+            auto const* c = static_cast<unsigned char const*>(p);
+            for (std::size_t i = 0; i < n; ++i) {
+                h1 = (h1 ^ c[i]) * 1099511628211ULL; // FNV-1a
+                h2 = (((h2 << 5) | (h2 >> 59)) ^ c[i]) * 0xff51afd7ed558ccdULL;
+            }
+            nbytes += static_cast<Long>(n);
+        }
+
+        template <typename T, std::enable_if_t<std::is_trivially_copyable_v<T>,int> = 0>
+        void add (T const& x) { add(&x, sizeof(T)); }
+
+        void add (BoxArray const& ba) {
+            add(ba.ixType());
+            add(ba.crseRatio());
+            add(ba.size());
+            for (int i = 0, N = static_cast<int>(ba.size()); i < N; ++i) {
+                add(ba[i]);
+            }
+        }
+
+        void add (DistributionMapping const& dm) {
+            auto const& pmap = dm.ProcessorMap();
+            add(pmap.size());
+            add(pmap.data(), sizeof(int)*pmap.size());
+        }
+
+        void add (Periodicity const& period) {
+            add(period.Domain());
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                add(period.isPeriodic(idim));
+            }
+        }
+
+        // The metadata also depend on the process, the threading and the
+        // tiling of local copies.
+        void add_environment () {
+            add(ParallelDescriptor::MyProc());
+            add(ParallelDescriptor::NProcs());
+            add(ParallelDescriptor::TeamSize());
+            add(OpenMP::get_max_threads());
+            add(FabArrayBase::comm_tile_size);
+        }
+    };
+
+    // A file holds the metadata of one of comm_metadata_max_files slots, so
+    // the directory does not grow without bound when the grids change.  A
+    // new layout that maps to an occupied slot replaces its file.
+    std::string comm_metadata_filename (std::string const& prefix, CommMetaDataKey const& key)
+    {
+        const auto nslots = static_cast<std::uint64_t>(std::max(FabArrayBase::comm_metadata_max_files, 1));
+        std::ostringstream ss;
+        ss << FabArrayBase::comm_metadata_dir << "/" << prefix << "_" << key.h1 % nslots << "_";
+        return amrex::Concatenate(ss.str(), ParallelDescriptor::MyProc(), 5);
+    }
+
+    constexpr int comm_metadata_version = 3;
+
+    void write_tags (std::ostream& os, FabArrayBase::CopyComTagsContainer const& tags)
+    {
+        const Long n = tags.size();
+        os.write(reinterpret_cast<char const*>(&n), sizeof(n));
+        os.write(reinterpret_cast<char const*>(tags.data()), n*sizeof(FabArrayBase::CopyComTag));
+    }
+
+    void read_tags (std::istream& is, FabArrayBase::CopyComTagsContainer& tags)
+    {
+        Long n = 0;
+        is.read(reinterpret_cast<char*>(&n), sizeof(n));
+        if (!is || n < 0) { is.setstate(std::ios::failbit); return; }
+        tags.resize(n);
+        is.read(reinterpret_cast<char*>(tags.data()), n*sizeof(FabArrayBase::CopyComTag));
+    }
+
+    void write_comm_metadata (FabArrayBase::CommMetaData const& cmd, std::string const& filename,
+                              CommMetaDataKey const& key)
+    {
+        if (!amrex::FileExists(FabArrayBase::comm_metadata_dir)) {
+            amrex::UtilCreateDirectory(FabArrayBase::comm_metadata_dir, 0755);
+        }
+
+        // Write to a temporary file first so that a reader never sees a
+        // partially written file.
+        const std::string tmpname = filename + ".tmp";
+        {
+            std::ofstream ofs(tmpname, std::ios::binary);
+            if (!ofs.good()) { return; } // The cache is optional.
+            ofs.write(reinterpret_cast<char const*>(&comm_metadata_version), sizeof(int));
+            ofs.write(reinterpret_cast<char const*>(&key.nbytes), sizeof(key.nbytes));
+            ofs.write(reinterpret_cast<char const*>(&key.h1), sizeof(key.h1));
+            ofs.write(reinterpret_cast<char const*>(&key.h2), sizeof(key.h2));
+            const int flags[2] = {int(cmd.m_threadsafe_loc), int(cmd.m_threadsafe_rcv)};
+            ofs.write(reinterpret_cast<char const*>(flags), sizeof(flags));
+            write_tags(ofs, *cmd.m_LocTags);
+            for (auto const* m : {cmd.m_SndTags.get(), cmd.m_RcvTags.get()}) {
+                const Long n = m->size();
+                ofs.write(reinterpret_cast<char const*>(&n), sizeof(n));
+                for (auto const& [rank, tags] : *m) {
+                    ofs.write(reinterpret_cast<char const*>(&rank), sizeof(rank));
+                    write_tags(ofs, tags);
+                }
+            }
+            if (!ofs.good()) {
+                ofs.close();
+                std::remove(tmpname.c_str());
+                return;
+            }
+        }
+        std::rename(tmpname.c_str(), filename.c_str());
+    }
+
+    bool read_comm_metadata (FabArrayBase::CommMetaData& cmd, std::string const& filename,
+                             CommMetaDataKey const& key)
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs.good()) { return false; }
+
+        // The file may hold another layout that shares the slot.
+        int version = 0;
+        CommMetaDataKey fkey;
+        ifs.read(reinterpret_cast<char*>(&version), sizeof(int));
+        ifs.read(reinterpret_cast<char*>(&fkey.nbytes), sizeof(fkey.nbytes));
+        ifs.read(reinterpret_cast<char*>(&fkey.h1), sizeof(fkey.h1));
+        ifs.read(reinterpret_cast<char*>(&fkey.h2), sizeof(fkey.h2));
+        if (!ifs || version != comm_metadata_version || fkey.nbytes != key.nbytes
+            || fkey.h1 != key.h1 || fkey.h2 != key.h2) { return false; }
+
+        FabArrayBase::CommMetaData tmp;
+        tmp.m_LocTags = std::make_unique<FabArrayBase::CopyComTagsContainer>();
+        tmp.m_SndTags = std::make_unique<FabArrayBase::MapOfCopyComTagContainers>();
+        tmp.m_RcvTags = std::make_unique<FabArrayBase::MapOfCopyComTagContainers>();
+        int flags[2] = {0, 0};
+        ifs.read(reinterpret_cast<char*>(flags), sizeof(flags));
+        tmp.m_threadsafe_loc = flags[0];
+        tmp.m_threadsafe_rcv = flags[1];
+        read_tags(ifs, *tmp.m_LocTags);
+        for (auto* m : {tmp.m_SndTags.get(), tmp.m_RcvTags.get()}) {
+            Long n = 0;
+            ifs.read(reinterpret_cast<char*>(&n), sizeof(n));
+            for (Long i = 0; ifs && i < n; ++i) {
+                int rank = -1;
+                ifs.read(reinterpret_cast<char*>(&rank), sizeof(rank));
+                read_tags(ifs, (*m)[rank]);
+            }
+        }
+        if (!ifs) { return false; }
+
+        cmd.m_threadsafe_loc = tmp.m_threadsafe_loc;
+        cmd.m_threadsafe_rcv = tmp.m_threadsafe_rcv;
+        cmd.m_LocTags = std::move(tmp.m_LocTags);
+        cmd.m_SndTags = std::move(tmp.m_SndTags);
+        cmd.m_RcvTags = std::move(tmp.m_RcvTags);
+        return true;
+    }
+}
+
 //
 // Stuff used for copy() caching.
 //
@@ -300,8 +537,28 @@ FabArrayBase::CPC::CPC (const FabArrayBase& dstfa, const IntVect& dstng,
       m_srcba(srcfa.boxArray()),
       m_dstba(dstfa.boxArray())
 {
+    std::string filename;
+    CommMetaDataKey key;
+    if (!comm_metadata_dir.empty()) {
+        key.add(m_dstba);
+        key.add(dstfa.DistributionMap());
+        key.add(m_srcba);
+        key.add(srcfa.DistributionMap());
+        key.add(m_dstng);
+        key.add(m_srcng);
+        key.add(m_period);
+        key.add(m_tgco);
+        key.add_environment();
+        filename = comm_metadata_filename("cpc", key);
+        if (read_comm_metadata(*this, filename, key)) { return; }
+    }
+
     this->define(m_dstba, dstfa.DistributionMap(), dstfa.IndexArray(),
                  m_srcba, srcfa.DistributionMap(), srcfa.IndexArray());
+
+    if (!filename.empty()) {
+        write_comm_metadata(*this, filename, key);
+    }
 }
 
 FabArrayBase::CPC::CPC (const BoxArray& dstba, const DistributionMapping& dstdm,
@@ -343,22 +600,23 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
         const int nlocal_dst = static_cast<int>(imap_dst.size());
         const IntVect& ng_dst = m_dstng;
 
-        std::vector< std::pair<int,Box> > isects;
-
         const std::vector<IntVect>& pshifts = m_period.shiftIntVect(ng_dst);
+        const int nshifts = static_cast<int>(pshifts.size());
 
         auto& send_tags = *m_SndTags;
 
+        BatchedIntersections snd_isects(ba_dst, ng_dst, nlocal_src, [&] (int i) {
+            return amrex::grow(ba_src[imap_src[i]], ng_src);
+        }, pshifts);
+
         for (int i = 0; i < nlocal_src; ++i)
         {
             const int   k_src = imap_src[i];
-            const Box& bx_src = amrex::grow(ba_src[k_src], ng_src);
 
-            for (auto const& pit : pshifts)
+            for (int j = 0; j < nshifts; ++j)
             {
-                ba_dst.intersections(bx_src+pit, isects, false, ng_dst);
-
-                for (auto const& is : isects)
+                const IntVect& pit = pshifts[j];
+                for (auto const& is : snd_isects(i,j))
                 {
                     const int k_dst     = is.first;
                     const Box& bx       = is.second;
@@ -367,9 +625,12 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
                     if (ParallelDescriptor::sameTeam(dst_owner)) {
                         continue; // local copy will be dealt with later
                     } else if (MyProc == dm_src[k_src]) {
-                        BoxList const bl_dst = m_tgco ? boxDiff(bx, ba_dst[k_dst]) : BoxList(bx);
-                        for (auto const& b : bl_dst) {
-                            send_tags[dst_owner].emplace_back(b, b-pit, k_dst, k_src);
+                        if (m_tgco) {
+                            for (auto const& b : boxDiff(bx, ba_dst[k_dst])) {
+                                send_tags[dst_owner].emplace_back(b, b-pit, k_dst, k_src);
+                            }
+                        } else {
+                            send_tags[dst_owner].emplace_back(bx, bx-pit, k_dst, k_src);
                         }
                     }
                 }
@@ -393,8 +654,13 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
             check_local = true;
         }
 
+        BatchedIntersections rcv_isects(ba_src, ng_src, nlocal_dst, [&] (int i) {
+            return amrex::grow(ba_dst[imap_dst[i]], ng_dst);
+        }, pshifts);
+
         m_threadsafe_loc = true;
         m_threadsafe_rcv = true;
+        BoxList bl_dst(ba_dst.ixType());
         for (int i = 0; i < nlocal_dst; ++i)
         {
             BoxList bl_local(ba_dst.ixType());
@@ -402,19 +668,22 @@ FabArrayBase::CPC::define (const BoxArray& ba_dst, const DistributionMapping& dm
 
             const int   k_dst = imap_dst[i];
             const Box& bx_dst_valid = ba_dst[k_dst];
-            const Box& bx_dst = amrex::grow(bx_dst_valid, ng_dst);
 
-            for (auto const& pit : pshifts)
+            for (int j = 0; j < nshifts; ++j)
             {
-                ba_src.intersections(bx_dst+pit, isects, false, ng_src);
-
-                for (auto const& is : isects)
+                const IntVect& pit = pshifts[j];
+                for (auto const& is : rcv_isects(i,j))
                 {
                     const int k_src     = is.first;
                     const Box& bx       = is.second - pit;
                     const int src_owner = dm_src[k_src];
 
-                    BoxList const bl_dst = m_tgco ? boxDiff(bx,bx_dst_valid) : BoxList(bx);
+                    if (m_tgco) {
+                        boxDiff(bl_dst, bx, bx_dst_valid);
+                    } else {
+                        bl_dst.clear();
+                        bl_dst.push_back(bx);
+                    }
                     for (auto const& b : bl_dst) {
                         if (ParallelDescriptor::sameTeam(src_owner, MyProc)) { // local copy
                             const BoxList tilelist(b, FabArrayBase::comm_tile_size);
@@ -670,23 +939,26 @@ FabArrayBase::define_fb_metadata (CommMetaData& cmd, const IntVect& nghost,
     const int nlocal = static_cast<int>(imap.size());
     const IntVect& ng = nghost;
     const IntVect ng_ng =nghost - 1;
-    std::vector< std::pair<int,Box> > isects;
 
     const std::vector<IntVect>& pshifts = period.shiftIntVect(nghost);
+    const int nshifts = static_cast<int>(pshifts.size());
 
     auto& send_tags = *cmd.m_SndTags;
 
+    BatchedIntersections snd_isects(ba, ng, nlocal, [&] (int i) {
+        return ba[imap[i]];
+    }, pshifts);
+
     for (int i = 0; i < nlocal; ++i)
     {
         const int ksnd = imap[i];
         const Box& vbx = ba[ksnd];
         const Box& vbx_ng  = amrex::grow(vbx,1);
 
-        for (auto const& pit : pshifts)
+        for (int j = 0; j < nshifts; ++j)
         {
-            ba.intersections(vbx+pit, isects, false, ng);
-
-            for (auto const& is : isects)
+            const IntVect& pit = pshifts[j];
+            for (auto const& is : snd_isects(i,j))
             {
                 const int krcv      = is.first;
                 const Box& bx       = is.second;
@@ -734,6 +1006,10 @@ FabArrayBase::define_fb_metadata (CommMetaData& cmd, const IntVect& nghost,
         check_local = true;
     }
 
+    BatchedIntersections rcv_isects(ba, IntVect(0), nlocal, [&] (int i) {
+        return amrex::grow(ba[imap[i]],ng);
+    }, pshifts);
+
     cmd.m_threadsafe_loc = true;
     cmd.m_threadsafe_rcv = true;
     for (int i = 0; i < nlocal; ++i)
@@ -746,11 +1022,10 @@ FabArrayBase::define_fb_metadata (CommMetaData& cmd, const IntVect& nghost,
         const Box& vbx_ng  = amrex::grow(vbx,1);
         const Box& bxrcv = amrex::grow(vbx, ng);
 
-        for (auto const& pit : pshifts)
+        for (int j = 0; j < nshifts; ++j)
         {
-            ba.intersections(bxrcv+pit, isects);
-
-            for (auto const& is : isects)
+            const IntVect& pit = pshifts[j];
+            for (auto const& is : rcv_isects(i,j))
             {
                 const int ksnd      = is.first;
                 const Box& dst_bx   = is.second - pit;
@@ -826,12 +1101,13 @@ FabArrayBase::define_fb_metadata (CommMetaData& cmd, const IntVect& nghost,
             std::vector<CopyComTag> cctv_tags_cross;
             cctv_tags_cross.reserve(cctv.size());
 
+            std::vector<Box> boxes;
             for (auto const& tag : cctv)
             {
                 const Box& bx = tag.dbox;
                 const IntVect& d2s = tag.sbox.smallEnd() - tag.dbox.smallEnd();
 
-                std::vector<Box> boxes;
+                boxes.clear();
                 if (cross) {
                     const Box& dstvbx = ba[tag.dstIndex];
                     for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
@@ -882,7 +1158,25 @@ FabArrayBase::FB::define_fb (const FabArrayBase& fa)
     AMREX_ASSERT(m_multi_ghost ? fa.nGrowVect().allGE(2) : true); // must have >= 2 ghost nodes
     AMREX_ASSERT(m_multi_ghost ? !m_period.isAnyPeriodic() : true); // this only works for non-periodic
 
+    std::string filename;
+    CommMetaDataKey key;
+    if (!comm_metadata_dir.empty()) {
+        key.add(fa.boxArray());
+        key.add(fa.DistributionMap());
+        key.add(m_ngrow);
+        key.add(m_cross);
+        key.add(m_multi_ghost);
+        key.add(m_period);
+        key.add_environment();
+        filename = comm_metadata_filename("fb", key);
+        if (read_comm_metadata(*this, filename, key)) { return; }
+    }
+
     fa.define_fb_metadata(*this, m_ngrow, m_cross, m_period, m_multi_ghost);
+
+    if (!filename.empty()) {
+        write_comm_metadata(*this, filename, key);
+    }
 }
 
 void
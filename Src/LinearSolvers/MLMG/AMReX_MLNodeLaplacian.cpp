@@ -132,6 +132,12 @@ MLNodeLaplacian::resizeMultiGrid (int new_size)
         }
     }
 
+    if (!   m_stencil_rp.empty()) {
+        if (m_stencil_rp[0].size() > new_size) {
+            m_stencil_rp[0].resize(new_size);
+        }
+    }
+
     if (!   m_s0_norm0.empty()) {
         if (m_s0_norm0[0].size() > new_size) {
             m_s0_norm0[0].resize(new_size);
@@ -466,6 +472,43 @@ MLNodeLaplacian::prepareForSolve ()
     buildStencil();
 }
 
+template <typename SFAB>
+void
+MLNodeLaplacian::restrictionSten (MultiFab& crse, MultiFab const& fine,
+                                  FabArray<SFAB> const& stencil, iMultiFab const& dmsk) const
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion()) {
+        auto crse_ma = crse.arrays();
+        auto fine_ma = fine.const_arrays();
+        auto msk_ma = dmsk.const_arrays();
+        auto st_ma = stencil.const_arrays();
+        ParallelFor(crse, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
+        {
+            mlndlap_restriction_rap(i,j,k,crse_ma[box_no],fine_ma[box_no],st_ma[box_no],msk_ma[box_no]);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(crse, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> cfab = crse.array(mfi);
+            Array4<Real const> const& ffab = fine.const_array(mfi);
+            Array4<int const> const& mfab = dmsk.const_array(mfi);
+            auto const& stfab = stencil.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                mlndlap_restriction_rap(i,j,k,cfab,ffab,stfab,mfab);
+            });
+        }
+    }
+}
+
 void
 MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab& fine) const
 {
@@ -483,7 +526,18 @@ MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab&
     MultiFab* pcrse = (need_parallel_copy) ? &cfine : &crse;
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][cmglev-1];
 
-    const auto& stencil = m_stencil[amrlev][cmglev-1];
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        if (m_stencil_rp[amrlev][cmglev-1]) {
+            restrictionSten(*pcrse, fine, *m_stencil_rp[amrlev][cmglev-1], dmsk);
+        } else {
+            restrictionSten(*pcrse, fine, *m_stencil[amrlev][cmglev-1], dmsk);
+        }
+        if (need_parallel_copy) {
+            crse.ParallelCopy(cfine);
+        }
+        return;
+    }
 
     bool regular_coarsening = true;
 #if (AMREX_SPACEDIM == 1)
@@ -507,29 +561,18 @@ MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab&
     auto msk_ma = dmsk.const_arrays();
 
     if (Gpu::inLaunchRegion()) {
-        if (m_coarsening_strategy == CoarseningStrategy::Sigma)
+        if (regular_coarsening)
         {
-            if (regular_coarsening)
-            {
-                ParallelFor(*pcrse, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
-                {
-                    mlndlap_restriction(i,j,k,pcrse_ma[box_no],fine_ma[box_no],msk_ma[box_no]);
-                });
-            }
-            else
+            ParallelFor(*pcrse, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
             {
-                ParallelFor(*pcrse, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
-                {
-                    mlndlap_semi_restriction(i,j,k,pcrse_ma[box_no],fine_ma[box_no],msk_ma[box_no],idir);
-                });
-            }
+                mlndlap_restriction(i,j,k,pcrse_ma[box_no],fine_ma[box_no],msk_ma[box_no]);
+            });
         }
         else
         {
-            auto st_ma = stencil->const_arrays();
             ParallelFor(*pcrse, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
             {
-                mlndlap_restriction_rap(i,j,k,pcrse_ma[box_no],fine_ma[box_no],st_ma[box_no],msk_ma[box_no]);
+                mlndlap_semi_restriction(i,j,k,pcrse_ma[box_no],fine_ma[box_no],msk_ma[box_no],idir);
             });
         }
         Gpu::streamSynchronize();
@@ -545,29 +588,18 @@ MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab&
             Array4<Real> cfab = pcrse->array(mfi);
             Array4<Real const> const& ffab = fine.const_array(mfi);
             Array4<int const> const& mfab = dmsk.const_array(mfi);
-            if (m_coarsening_strategy == CoarseningStrategy::Sigma)
+            if (regular_coarsening)
             {
-                if (regular_coarsening)
-                {
-                    amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
-                    {
-                        mlndlap_restriction(i,j,k,cfab,ffab,mfab);
-                    });
-                }
-                else
+                amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
                 {
-                    amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
-                    {
-                        mlndlap_semi_restriction(i,j,k,cfab,ffab,mfab,idir);
-                    });
-                }
+                    mlndlap_restriction(i,j,k,cfab,ffab,mfab);
+                });
             }
             else
             {
-                Array4<Real const> const& stfab = stencil->const_array(mfi);
                 amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
                 {
-                    mlndlap_restriction_rap(i,j,k,cfab,ffab,stfab,mfab);
+                    mlndlap_semi_restriction(i,j,k,cfab,ffab,mfab,idir);
                 });
             }
         }
@@ -578,13 +610,49 @@ MLNodeLaplacian::restriction (int amrlev, int cmglev, MultiFab& crse, MultiFab&
     }
 }
 
+template <typename SFAB>
+void
+MLNodeLaplacian::interpolationSten (MultiFab& fine, MultiFab const& crse,
+                                    FabArray<SFAB> const& stencil, iMultiFab const& dmsk) const
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion()) {
+        auto fine_ma = fine.arrays();
+        auto crse_ma = crse.const_arrays();
+        auto msk_ma = dmsk.const_arrays();
+        auto sten_ma = stencil.const_arrays();
+        ParallelFor(fine, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
+        {
+            mlndlap_interpadd_rap(i, j, k, fine_ma[box_no], crse_ma[box_no], sten_ma[box_no], msk_ma[box_no]);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(fine, true); mfi.isValid(); ++mfi)
+        {
+            Box const& bx = mfi.tilebox();
+            Array4<Real> const& ffab = fine.array(mfi);
+            Array4<Real const> const& cfab = crse.const_array(mfi);
+            Array4<int const> const& mfab = dmsk.const_array(mfi);
+            auto const& stfab = stencil.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                mlndlap_interpadd_rap(i,j,k,ffab,cfab,stfab,mfab);
+            });
+        }
+    }
+}
+
 void
 MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const MultiFab& crse) const
 {
     BL_PROFILE("MLNodeLaplacian::interpolation()");
 
     const auto& sigma = m_sigma[amrlev][fmglev];
-    const auto& stencil = m_stencil[amrlev][fmglev];
 
     bool need_parallel_copy = !amrex::isMFIterSafe(crse, fine);
     MultiFab cfine;
@@ -598,6 +666,16 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
 
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][fmglev];
 
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        if (m_stencil_rp[amrlev][fmglev]) {
+            interpolationSten(fine, *cmf, *m_stencil_rp[amrlev][fmglev], dmsk);
+        } else {
+            interpolationSten(fine, *cmf, *m_stencil[amrlev][fmglev], dmsk);
+        }
+        return;
+    }
+
     bool regular_coarsening = true;
 #if (AMREX_SPACEDIM == 1)
     int idir = 0;
@@ -623,15 +701,7 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
     auto msk_ma = dmsk.const_arrays();
 
     if (Gpu::inLaunchRegion()) {
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-            auto sten_ma = stencil->const_arrays();
-            ParallelFor(fine, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
-            {
-                mlndlap_interpadd_rap(i, j, k, fine_ma[box_no], crse_ma[box_no], sten_ma[box_no], msk_ma[box_no]);
-            });
-        }
-        else if (sigma[0] == nullptr)
+        if (sigma[0] == nullptr)
         {
             ParallelFor(fine, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
             {
@@ -678,15 +748,7 @@ MLNodeLaplacian::interpolation (int amrlev, int fmglev, MultiFab& fine, const Mu
             Array4<Real> const& ffab = fine.array(mfi);
             Array4<Real const> const& cfab = cmf->const_array(mfi);
             Array4<int const> const& mfab = dmsk.const_array(mfi);
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
-            {
-                Array4<Real const> const& stfab = stencil->const_array(mfi);
-                amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
-                {
-                    mlndlap_interpadd_rap(i,j,k,ffab,cfab,stfab,mfab);
-                });
-            }
-            else if (sigma[0] == nullptr)
+            if (sigma[0] == nullptr)
             {
                 amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
                 {
@@ -835,6 +897,43 @@ MLNodeLaplacian::restrictInteriorNodes (int camrlev, MultiFab& crhs, MultiFab& a
     }
 }
 
+template <typename SFAB>
+void
+MLNodeLaplacian::normalizeSten (MultiFab& mf, FabArray<SFAB> const& stencil,
+                                iMultiFab const& dmsk, Real s0_norm0) const
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion() && mf.isFusingCandidate()) {
+        const auto& ma = mf.arrays();
+        const auto& dmsk_ma = dmsk.const_arrays();
+        const auto& sten_ma = stencil.const_arrays();
+        ParallelFor(mf,
+        [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+        {
+            mlndlap_normalize_sten(i,j,k,ma[box_no],sten_ma[box_no],dmsk_ma[box_no],s0_norm0);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real> const& arr = mf.array(mfi);
+            Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+            auto const& stenarr = stencil.const_array(mfi);
+
+            AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
+            {
+                mlndlap_normalize_sten(i,j,k,arr,stenarr,dmskarr,s0_norm0);
+            });
+        }
+    }
+}
+
 void
 MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
 {
@@ -843,26 +942,26 @@ MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
     if (m_sigma[0][0][0] == nullptr) { return; }
 
     const auto& sigma = m_sigma[amrlev][mglev];
-    const auto& stencil = m_stencil[amrlev][mglev];
     const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][mglev];
-    const Real s0_norm0 = m_s0_norm0[amrlev][mglev];
+
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        const Real s0_norm0 = m_s0_norm0[amrlev][mglev];
+        if (m_stencil_rp[amrlev][mglev]) {
+            normalizeSten(mf, *m_stencil_rp[amrlev][mglev], dmsk, s0_norm0);
+        } else {
+            normalizeSten(mf, *m_stencil[amrlev][mglev], dmsk, s0_norm0);
+        }
+        return;
+    }
 
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion() && mf.isFusingCandidate()) {
         const auto& ma = mf.arrays();
         const auto& dmsk_ma = dmsk.const_arrays();
 
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-            const auto& sten_ma = stencil->const_arrays();
-            ParallelFor(mf,
-            [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
-            {
-                mlndlap_normalize_sten(i,j,k,ma[box_no],sten_ma[box_no],dmsk_ma[box_no],s0_norm0);
-            });
-        }
-        else if ( (m_use_harmonic_average && mglev > 0) ||
+        if ( (m_use_harmonic_average && mglev > 0) ||
                    m_use_mapped )
         {
             AMREX_D_TERM(const auto& sx_ma = sigma[0]->const_arrays();,
@@ -895,16 +994,7 @@ MLNodeLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
             const Box& bx = mfi.tilebox();
             Array4<Real> const& arr = mf.array(mfi);
             Array4<int const> const& dmskarr = dmsk.const_array(mfi);
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
-            {
-                Array4<Real const> const& stenarr = stencil->const_array(mfi);
-
-                AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
-                {
-                    mlndlap_normalize_sten(i,j,k,arr,stenarr,dmskarr,s0_norm0);
-                });
-            }
-            else if ( (m_use_harmonic_average && mglev > 0) ||
+            if ( (m_use_harmonic_average && mglev > 0) ||
                        m_use_mapped )
             {
                 AMREX_D_TERM(Array4<Real const> const& sxarr = sigma[0]->const_array(mfi);,
@@ -195,13 +195,49 @@ MLNodeLaplacian::averageDownCoeffsSameAmrLevel (int amrlev)
     }
 }
 
+template <typename SFAB>
+void
+MLNodeLaplacian::FapplySten (MultiFab& out, const MultiFab& in,
+                             FabArray<SFAB> const& stencil, iMultiFab const& dmsk) const
+{
+#ifdef AMREX_USE_GPU
+    if (Gpu::inLaunchRegion()) {
+        auto xarr_ma = in.const_arrays();
+        auto yarr_ma = out.arrays();
+        auto dmskarr_ma = dmsk.const_arrays();
+        auto stenarr_ma = stencil.const_arrays();
+        ParallelFor(out, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
+        {
+            yarr_ma[box_no](i,j,k) = mlndlap_adotx_sten(i,j,k,xarr_ma[box_no],stenarr_ma[box_no],dmskarr_ma[box_no]);
+        });
+        Gpu::streamSynchronize();
+    } else
+#endif
+    {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(out,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Array4<Real const> const& xarr = in.const_array(mfi);
+            Array4<Real> const& yarr = out.array(mfi);
+            Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+            auto const& stenarr = stencil.const_array(mfi);
+            amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
+            {
+                yarr(i,j,k) = mlndlap_adotx_sten(i,j,k,xarr,stenarr,dmskarr);
+            });
+        }
+    }
+}
+
 void
 MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) const
 {
     BL_PROFILE("MLNodeLaplacian::Fapply()");
 
     const auto& sigma = m_sigma[amrlev][mglev];
-    const auto& stencil = m_stencil[amrlev][mglev];
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -209,6 +245,15 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
 
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][mglev];
 
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        if (m_stencil_rp[amrlev][mglev]) {
+            FapplySten(out, in, *m_stencil_rp[amrlev][mglev], dmsk);
+        } else {
+            FapplySten(out, in, *m_stencil[amrlev][mglev], dmsk);
+        }
+        return;
+    }
 
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
@@ -216,15 +261,7 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
         auto yarr_ma = out.arrays();
         auto dmskarr_ma = dmsk.const_arrays();
 
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-            auto stenarr_ma = stencil->const_arrays();
-            ParallelFor(out, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
-            {
-                yarr_ma[box_no](i,j,k) = mlndlap_adotx_sten(i,j,k,xarr_ma[box_no],stenarr_ma[box_no],dmskarr_ma[box_no]);
-            });
-        }
-        else if (sigma[0] == nullptr)
+        if (sigma[0] == nullptr)
         {
             Real const_sigma = m_const_sigma;
             ParallelFor(out, [=] AMREX_GPU_DEVICE(int box_no, int i, int j, int k) noexcept
@@ -279,15 +316,7 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
             Array4<Real> const& yarr = out.array(mfi);
             Array4<int const> const& dmskarr = dmsk.const_array(mfi);
 
-            if (m_coarsening_strategy == CoarseningStrategy::RAP)
-            {
-                Array4<Real const> const& stenarr = stencil->const_array(mfi);
-                amrex::LoopConcurrentOnCpu(bx, [&] (int i, int j, int k) noexcept
-                {
-                    yarr(i,j,k) = mlndlap_adotx_sten(i,j,k,xarr,stenarr,dmskarr);
-                });
-            }
-            else if (sigma[0] == nullptr)
+            if (sigma[0] == nullptr)
             {
                 Real const_sigma = m_const_sigma;
 #if (AMREX_SPACEDIM == 2)
@@ -341,13 +370,98 @@ MLNodeLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
     }
 }
 
+template <typename SFAB>
+void
+MLNodeLaplacian::FsmoothSten (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
+                              FabArray<SFAB> const& stencil, iMultiFab const& dmsk) const
+{
+#ifdef AMREX_USE_GPU
+    auto const& solarr_ma = sol.arrays();
+    auto const& rhsarr_ma = rhs.const_arrays();
+    auto const& dmskarr_ma = dmsk.const_arrays();
+    auto const& starr_ma = stencil.const_arrays();
+#endif
+
+    if (m_use_gauss_seidel)
+    {
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion())
+        {
+            for (int color = 0; color < AMREX_D_TERM(2,*2,*2); ++color)
+            {
+                ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+                {
+                    mlndlap_gscolor_sten(i,j,k,solarr_ma[box_no],rhsarr_ma[box_no],
+                                         starr_ma[box_no],dmskarr_ma[box_no],color);
+                });
+            }
+        } else
+#endif
+        {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            for (MFIter mfi(sol); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+                Array4<Real> const& solarr = sol.array(mfi);
+                Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+                auto const& starr = stencil.const_array(mfi);
+                Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+                for (int ns = 0; ns < m_smooth_num_sweeps; ++ns) {
+                    mlndlap_gauss_seidel_sten(bx,solarr,rhsarr,starr,dmskarr);
+                }
+            }
+        }
+
+        Gpu::streamSynchronize();
+        nodalSync(amrlev, mglev, sol);
+    }
+    else
+    {
+        MultiFab Ax(sol.boxArray(), sol.DistributionMap(), 1, 0);
+        FapplySten(Ax, sol, stencil, dmsk);
+
+#ifdef AMREX_USE_GPU
+        if (Gpu::inLaunchRegion())
+        {
+            auto const& Axarr_ma = Ax.const_arrays();
+            ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+            {
+                mlndlap_jacobi_sten(i,j,k,solarr_ma[box_no],Axarr_ma[box_no](i,j,k),
+                                    rhsarr_ma[box_no],starr_ma[box_no],
+                                    dmskarr_ma[box_no]);
+            });
+        } else
+#endif
+        {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            for (MFIter mfi(sol,true); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+                Array4<Real> const& solarr = sol.array(mfi);
+                Array4<Real const> const& Axarr = Ax.const_array(mfi);
+                Array4<Real const> const& rhsarr = rhs.const_array(mfi);
+                auto const& stenarr = stencil.const_array(mfi);
+                Array4<int const> const& dmskarr = dmsk.const_array(mfi);
+
+                mlndlap_jacobi_sten(bx,solarr,Axarr,rhsarr,stenarr,dmskarr);
+            }
+        }
+
+        Gpu::streamSynchronize();
+    }
+}
+
 void
 MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs) const
 {
     BL_PROFILE("MLNodeLaplacian::Fsmooth()");
 
     const auto& sigma = m_sigma[amrlev][mglev];
-    const auto& stencil = m_stencil[amrlev][mglev];
     const auto dxinvarr = m_geom[amrlev][mglev].InvCellSizeArray();
 #if (AMREX_SPACEDIM == 2)
     bool is_rz = m_is_rz;
@@ -355,6 +469,16 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 
     const iMultiFab& dmsk = *m_dirichlet_mask[amrlev][mglev];
 
+    if (m_coarsening_strategy == CoarseningStrategy::RAP)
+    {
+        if (m_stencil_rp[amrlev][mglev]) {
+            FsmoothSten(amrlev, mglev, sol, rhs, *m_stencil_rp[amrlev][mglev], dmsk);
+        } else {
+            FsmoothSten(amrlev, mglev, sol, rhs, *m_stencil[amrlev][mglev], dmsk);
+        }
+        return;
+    }
+
 #ifdef AMREX_USE_GPU
     auto const& solarr_ma = sol.arrays();
     auto const& rhsarr_ma = rhs.const_arrays();
@@ -372,41 +496,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 
     if (m_use_gauss_seidel)
     {
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-#ifdef AMREX_USE_GPU
-            if (Gpu::inLaunchRegion())
-            {
-                auto const& starr_ma = stencil->const_arrays();
-                for (int color = 0; color < AMREX_D_TERM(2,*2,*2); ++color)
-                {
-                    ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
-                    {
-                        mlndlap_gscolor_sten(i,j,k,solarr_ma[box_no],rhsarr_ma[box_no],
-                                             starr_ma[box_no],dmskarr_ma[box_no],color);
-                    });
-                }
-            } else
-#endif
-            {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-                for (MFIter mfi(sol); mfi.isValid(); ++mfi)
-                {
-                    const Box& bx = mfi.validbox();
-                    Array4<Real> const& solarr = sol.array(mfi);
-                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
-                    Array4<Real const> const& starr = stencil->const_array(mfi);
-                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
-
-                    for (int ns = 0; ns < m_smooth_num_sweeps; ++ns) {
-                        mlndlap_gauss_seidel_sten(bx,solarr,rhsarr,starr,dmskarr);
-                    }
-                }
-            }
-        }
-        else if (sigma[0] == nullptr)
+        if (sigma[0] == nullptr)
         {
             Real const_sigma = m_const_sigma;
 #ifdef AMREX_USE_GPU
@@ -570,38 +660,7 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
         auto const& Axarr_ma = Ax.const_arrays();
 #endif
 
-        if (m_coarsening_strategy == CoarseningStrategy::RAP)
-        {
-#ifdef AMREX_USE_GPU
-            if (Gpu::inLaunchRegion())
-            {
-                auto const& starr_ma = stencil->const_arrays();
-                ParallelFor(sol, [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
-                {
-                    mlndlap_jacobi_sten(i,j,k,solarr_ma[box_no],Axarr_ma[box_no](i,j,k),
-                                        rhsarr_ma[box_no],starr_ma[box_no],
-                                        dmskarr_ma[box_no]);
-                });
-            } else
-#endif
-            {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-                for (MFIter mfi(sol,true); mfi.isValid(); ++mfi)
-                {
-                    const Box& bx = mfi.tilebox();
-                    Array4<Real> const& solarr = sol.array(mfi);
-                    Array4<Real const> const& Axarr = Ax.const_array(mfi);
-                    Array4<Real const> const& rhsarr = rhs.const_array(mfi);
-                    Array4<Real const> const& stenarr = stencil->const_array(mfi);
-                    Array4<int const> const& dmskarr = dmsk.const_array(mfi);
-
-                    mlndlap_jacobi_sten(bx,solarr,Axarr,rhsarr,stenarr,dmskarr);
-                }
-            }
-        }
-        else if (sigma[0] == nullptr)
+        if (sigma[0] == nullptr)
         {
             Real const_sigma = m_const_sigma;
 #ifdef AMREX_USE_GPU
@@ -17,11 +17,14 @@ void
 MLNodeLaplacian::buildStencil ()
 {
     m_stencil.resize(m_num_amr_levels);
+    m_stencil_rp.clear();
+    m_stencil_rp.resize(m_num_amr_levels);
     m_nosigma_stencil.resize(m_num_amr_levels);
     m_s0_norm0.resize(m_num_amr_levels);
     for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
     {
         m_stencil[amrlev].resize(m_num_mg_levels[amrlev]);
+        m_stencil_rp[amrlev].resize(m_num_mg_levels[amrlev]);
         m_s0_norm0[amrlev].resize(m_num_mg_levels[amrlev],0.0);
     }
 
@@ -363,6 +366,50 @@ MLNodeLaplacian::buildStencil ()
 
     // This is only needed at the bottom.
     m_s0_norm0[0].back() = m_stencil[0].back()->norm0(0,0) * m_normalization_threshold;
+
+    if (m_use_rp_stencil) {
+        convertStencilToReducedPrecision();
+    }
+}
+
+void
+MLNodeLaplacian::convertStencilToReducedPrecision ()
+{
+    BL_PROFILE("MLNodeLaplacian::convertStencilToReducedPrecision()");
+
+    if constexpr (std::is_same_v<Real,float>) {
+        return;
+    } else {
+        m_stencil_rp.resize(m_num_amr_levels);
+        for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
+        {
+            m_stencil_rp[amrlev].resize(m_num_mg_levels[amrlev]);
+            // The finest MG level is needed in full precision for the
+            // residual, and the bottom level is used by the bottom solvers.
+            for (int mglev = 1; mglev < m_num_mg_levels[amrlev]; ++mglev)
+            {
+                if (amrlev == 0 && mglev+1 == m_num_mg_levels[amrlev]) { continue; }
+
+                auto& stencil = m_stencil[amrlev][mglev];
+                if (stencil == nullptr) { continue; }
+
+                auto rp = std::make_unique<FabArray<BaseFab<float> > >
+                    (stencil->boxArray(), stencil->DistributionMap(),
+                     stencil->nComp(), stencil->nGrowVect());
+                auto const& sma = stencil->const_arrays();
+                auto const& rma = rp->arrays();
+                ParallelFor(*rp, rp->nGrowVect(), rp->nComp(),
+                [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k, int n) noexcept
+                {
+                    rma[box_no](i,j,k,n) = static_cast<float>(sma[box_no](i,j,k,n));
+                });
+                Gpu::streamSynchronize();
+
+                m_stencil_rp[amrlev][mglev] = std::move(rp);
+                stencil.reset();
+            }
+        }
+    }
 }
 
 }
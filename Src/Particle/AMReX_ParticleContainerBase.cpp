@@ -10,6 +10,9 @@ using namespace amrex;
 bool    ParticleContainerBase::do_tiling = false;
 IntVect ParticleContainerBase::tile_size { AMREX_D_DECL(1024000,8,8) };
 bool    ParticleContainerBase::memEfficientSort = true;
+ParticleSortPolicy ParticleContainerBase::default_sort_policy;
+Real    ParticleContainerBase::default_shrink_threshold = 0.0;
+bool    ParticleContainerBase::binned_deposition = false;
 
 void ParticleContainerBase::Define (const Geometry            & geom,
                                     const DistributionMapping & dmap,
@@ -68,6 +71,23 @@ void ParticleContainerBase::RedefineDummyMF (int lev)
     };
 }
 
+MultiFab&
+ParticleContainerBase::DualGridBuffer (int lev, int ncomp, const IntVect& ngrow) const
+{
+    if (lev >= m_dual_grid_buffer.size()) { m_dual_grid_buffer.resize(lev+1); }
+
+    auto& buf = m_dual_grid_buffer[lev];
+    if (buf == nullptr ||
+        ! BoxArray::SameRefs(buf->boxArray(), ParticleBoxArray(lev)) ||
+        ! DistributionMapping::SameRefs(buf->DistributionMap(), ParticleDistributionMap(lev)) ||
+        buf->nGrowVect() != ngrow || buf->nComp() < ncomp)
+    {
+        buf = std::make_unique<MultiFab>(ParticleBoxArray(lev), ParticleDistributionMap(lev),
+                                         ncomp, ngrow);
+    }
+    return *buf;
+}
+
 void
 ParticleContainerBase::defineBufferMap () const
 {
@@ -328,3 +348,49 @@ void ParticleContainerBase::BuildRedistributeMask (int lev, int nghost) const
         RemoveDuplicates(neighbor_procs);
     }
 }
+
+Vector<int> ParticleContainerBase::NeighborProcs (int ngrow) const
+{
+    const int num_levs = finestLevel() + 1;
+    bool valid = (ngrow == m_neighbor_procs_ngrow) && (num_levs == m_neighbor_procs_ba.size());
+    for (int lev = 0; valid && lev < num_levs; ++lev) {
+        valid = BoxArray::SameRefs(ParticleBoxArray(lev), m_neighbor_procs_ba[lev]) &&
+            DistributionMapping::SameRefs(ParticleDistributionMap(lev), m_neighbor_procs_dm[lev]);
+    }
+
+    if (! valid)
+    {
+        m_neighbor_procs_cache = computeNeighborProcs(this->GetParGDB(), ngrow);
+        m_neighbor_procs_ngrow = ngrow;
+        m_neighbor_procs_ba.resize(num_levs);
+        m_neighbor_procs_dm.resize(num_levs);
+        for (int lev = 0; lev < num_levs; ++lev) {
+            m_neighbor_procs_ba[lev] = ParticleBoxArray(lev);
+            m_neighbor_procs_dm[lev] = ParticleDistributionMap(lev);
+        }
+    }
+
+    return m_neighbor_procs_cache;
+}
+
+int ParticleContainerBase::effectiveRedistributeLocal (int lev_min, int lev_max, int local) const
+{
+    // The local algorithm only handles level 0, and it is only safe while the grids are
+    // those the particles were last redistributed on: after a regrid they may be anywhere.
+    if (local > 0 || m_local_redistribute <= 0 || lev_min != 0 || finestLevel() != 0 ||
+        lev_max > 0) {
+        return local;
+    }
+    if (BoxArray::SameRefs(m_redistributed_ba, ParticleBoxArray(0)) &&
+        DistributionMapping::SameRefs(m_redistributed_dm, ParticleDistributionMap(0))) {
+        return m_local_redistribute;
+    }
+    return local;
+}
+
+void ParticleContainerBase::setRedistributedGrids ()
+{
+    if (m_gdb == nullptr || ! m_gdb->LevelDefined(0)) { return; }
+    m_redistributed_ba = ParticleBoxArray(0);
+    m_redistributed_dm = ParticleDistributionMap(0);
+}
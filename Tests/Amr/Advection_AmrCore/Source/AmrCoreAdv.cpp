@@ -269,8 +269,16 @@ AmrCoreAdv::RemakeLevel (int lev, Real time, const BoxArray& ba,
     MultiFab new_state(ba, dm, ncomp, ng);
     MultiFab old_state(ba, dm, ncomp, ng);
 
-    // Must use fillpatch_function
-    FillPatch(lev, time, new_state, 0, ncomp, FillPatchType::fillpatch_function);
+    // Must use fillpatch_function.
+    if (ReuseUnchangedGrids()) {
+        // Grids that are unchanged keep their data without a FillPatch.
+        FillPatchIncremental(new_state, phi_new[lev], [&] (MultiFab& mf)
+        {
+            FillPatch(lev, time, mf, 0, ncomp, FillPatchType::fillpatch_function);
+        });
+    } else {
+        FillPatch(lev, time, new_state, 0, ncomp, FillPatchType::fillpatch_function);
+    }
 
     std::swap(new_state, phi_new[lev]);
     std::swap(old_state, phi_old[lev]);
@@ -0,0 +1,41 @@
+#
+# Check that two runs wrote bitwise identical plotfiles.  The job_info
+# files hold timings and are skipped.
+#
+# Usage: cmake -DDIR_A=<run directory> -DDIR_B=<run directory> -P ComparePlotfiles.cmake
+#
+function (list_plotfile_data _dir _out)
+   file(GLOB _plotfiles LIST_DIRECTORIES true RELATIVE ${_dir}
+      ${_dir}/plt[0-9][0-9][0-9][0-9][0-9])
+   set(_files)
+   foreach(_plt IN LISTS _plotfiles)
+      file(GLOB_RECURSE _plt_files RELATIVE ${_dir} ${_dir}/${_plt}/*)
+      list(APPEND _files ${_plt_files})
+   endforeach()
+   list(FILTER _files EXCLUDE REGEX "job_info$")
+   list(SORT _files)
+   set(${_out} ${_files} PARENT_SCOPE)
+endfunction ()
+
+list_plotfile_data(${DIR_A} _files_a)
+list_plotfile_data(${DIR_B} _files_b)
+
+if (NOT _files_a)
+   message(FATAL_ERROR "No plotfiles in ${DIR_A}")
+endif ()
+
+if (NOT _files_a STREQUAL _files_b)
+   message(FATAL_ERROR "${DIR_A} and ${DIR_B} hold different plotfiles")
+endif ()
+
+foreach(_file IN LISTS _files_a)
+   execute_process(
+      COMMAND ${CMAKE_COMMAND} -E compare_files ${DIR_A}/${_file} ${DIR_B}/${_file}
+      RESULT_VARIABLE _result)
+   if (NOT _result EQUAL 0)
+      message(FATAL_ERROR "${_file} differs between ${DIR_A} and ${DIR_B}")
+   endif ()
+endforeach()
+
+list(LENGTH _files_a _nfiles)
+message(STATUS "${_nfiles} plotfile files are identical")
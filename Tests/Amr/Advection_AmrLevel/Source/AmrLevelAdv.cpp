@@ -200,7 +200,13 @@ AmrLevelAdv::init (AmrLevel &old)
 
     MultiFab& S_new = get_new_data(Phi_Type);
 
-    FillPatch(old, S_new, 0, cur_time, Phi_Type, 0, NUM_STATE);
+    if (parent->ReuseUnchangedGrids()) {
+        // The old data are no longer needed, so the data of unchanged grids
+        // can be moved.
+        FillPatchIncremental(old, S_new, cur_time, Phi_Type, 0, NUM_STATE);
+    } else {
+        FillPatch(old, S_new, 0, cur_time, Phi_Type, 0, NUM_STATE);
+    }
 }
 
 /**
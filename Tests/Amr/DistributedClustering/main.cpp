@@ -0,0 +1,162 @@
+#include <AMReX.H>
+#include <AMReX_AmrCore.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_TagBox.H>
+
+using namespace amrex;
+
+// Make the grids of an AmrCore with serial and with distributed clustering
+// (amr.use_distributed_clustering), and check that the grids of both cover
+// all tagged cells.
+
+namespace {
+
+// Tag a spherical shell and a small ball away from it.
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+bool is_tagged (AMREX_D_DECL(Real x, Real y, Real z))
+{
+    Real r1 = std::sqrt(AMREX_D_TERM((x-Real(0.45))*(x-Real(0.45)),
+                                     +(y-Real(0.5))*(y-Real(0.5)),
+                                     +(z-Real(0.55))*(z-Real(0.55))));
+    Real r2 = std::sqrt(AMREX_D_TERM((x-Real(0.8))*(x-Real(0.8)),
+                                     +(y-Real(0.2))*(y-Real(0.2)),
+                                     +(z-Real(0.3))*(z-Real(0.3))));
+    return (r1 > Real(0.2) && r1 < Real(0.25)) || r2 < Real(0.06);
+}
+
+class TagMesh
+    : public AmrCore
+{
+public:
+    using AmrCore::AmrCore;
+
+    void ErrorEst (int lev, TagBoxArray& tags, Real /*time*/, int /*ngrow*/) override
+    {
+        auto const problo = Geom(lev).ProbLoArray();
+        auto const dx = Geom(lev).CellSizeArray();
+        auto const& ta = tags.arrays();
+        ParallelFor(tags, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+        {
+            amrex::ignore_unused(j,k);
+            if (is_tagged(AMREX_D_DECL(problo[0]+(i+Real(0.5))*dx[0],
+                                       problo[1]+(j+Real(0.5))*dx[1],
+                                       problo[2]+(k+Real(0.5))*dx[2]))) {
+                ta[b](i,j,k) = TagBox::SET;
+            }
+        });
+    }
+
+    void MakeNewLevelFromScratch (int /*lev*/, Real /*time*/, const BoxArray& /*ba*/,
+                                  const DistributionMapping& /*dm*/) override {}
+    void MakeNewLevelFromCoarse (int /*lev*/, Real /*time*/, const BoxArray& /*ba*/,
+                                 const DistributionMapping& /*dm*/) override {}
+    void RemakeLevel (int /*lev*/, Real /*time*/, const BoxArray& /*ba*/,
+                      const DistributionMapping& /*dm*/) override {}
+    void ClearLevel (int /*lev*/) override {}
+};
+
+// Count the tagged cells of level lev that are not covered by the grids of
+// level lev+1.
+Long num_uncovered_tags (TagMesh const& mesh, int lev)
+{
+    BoxArray const& fba = mesh.boxArray(lev+1);
+    IntVect const rr = mesh.refRatio(lev);
+    auto const problo = mesh.Geom(lev).ProbLoArray();
+    auto const dx = mesh.Geom(lev).CellSizeArray();
+
+    Long nuncovered = 0;
+    BoxArray const& cba = mesh.boxArray(lev);
+    DistributionMapping const& cdm = mesh.DistributionMap(lev);
+    for (int ibox = 0; ibox < static_cast<int>(cba.size()); ++ibox) {
+        if (cdm[ibox] != ParallelDescriptor::MyProc()) { continue; }
+        auto const& bx = cba[ibox];
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+        {
+            amrex::ignore_unused(j,k);
+            if (is_tagged(AMREX_D_DECL(problo[0]+(i+Real(0.5))*dx[0],
+                                       problo[1]+(j+Real(0.5))*dx[1],
+                                       problo[2]+(k+Real(0.5))*dx[2]))) {
+                IntVect iv(AMREX_D_DECL(i,j,k));
+                if (!fba.contains(amrex::refine(Box(iv,iv), rr))) {
+                    ++nuncovered;
+                }
+            }
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(nuncovered);
+    return nuncovered;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 64;
+        int max_level = 2;
+        int max_grid_size = 16;
+        int blocking_factor = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_level", max_level);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("blocking_factor", blocking_factor);
+        }
+
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)),
+                      RealBox(AMREX_D_DECL(0.,0.,0.), AMREX_D_DECL(1.,1.,1.)),
+                      CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+
+        Vector<Vector<BoxArray>> all_grids;
+        for (bool distributed : {false, true}) {
+            AmrInfo info;
+            info.max_level = max_level;
+            info.max_grid_size = {IntVect(max_grid_size)};
+            info.blocking_factor = {IntVect(blocking_factor)};
+            info.use_distributed_clustering = distributed;
+
+            TagMesh mesh(geom, info);
+            mesh.InitFromScratch(0.0);
+
+            amrex::Print() << (distributed ? "Distributed" : "Serial")
+                           << " clustering: finest level = " << mesh.finestLevel() << "\n";
+            AMREX_ALWAYS_ASSERT(mesh.finestLevel() == max_level);
+
+            Vector<BoxArray> grids;
+            for (int lev = 0; lev <= mesh.finestLevel(); ++lev) {
+                BoxArray const& ba = mesh.boxArray(lev);
+                amrex::Print() << "  level " << lev << ": " << ba.size() << " grids, "
+                               << ba.numPts() << " cells\n";
+                AMREX_ALWAYS_ASSERT(ba.isDisjoint());
+                AMREX_ALWAYS_ASSERT(ba.coarsenable(IntVect(blocking_factor)));
+                if (lev < mesh.finestLevel()) {
+                    AMREX_ALWAYS_ASSERT(num_uncovered_tags(mesh, lev) == 0);
+                }
+                if (lev > 0) {
+                    // Proper nesting
+                    BoxArray cba = amrex::coarsen(ba, mesh.refRatio(lev-1));
+                    AMREX_ALWAYS_ASSERT(mesh.boxArray(lev-1).contains(cba));
+                }
+                grids.push_back(ba);
+            }
+            all_grids.push_back(std::move(grids));
+        }
+
+        // With more than one process the grids may differ, because the
+        // clusters are chopped differently.  On one process they must not.
+        for (int lev = 1; lev <= max_level; ++lev) {
+            auto const& serial = all_grids[0][lev];
+            auto const& distributed = all_grids[1][lev];
+            bool same = serial.contains(distributed) && distributed.contains(serial);
+            amrex::Print() << "Level " << lev << ": serial and distributed clustering cover "
+                           << (same ? "the same" : "different") << " regions\n";
+            if (ParallelDescriptor::NProcs() == 1) {
+                AMREX_ALWAYS_ASSERT(same);
+            }
+        }
+    }
+    amrex::Finalize();
+}
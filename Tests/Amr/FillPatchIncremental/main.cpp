@@ -0,0 +1,141 @@
+#include <AMReX.H>
+#include <AMReX_FillPatchUtil.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParReduce.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+// FillPatchIncremental moves the FABs of unchanged boxes from the old MF by
+// swapping them. Check the result, and that MultiArray4s obtained from arrays()
+// before the call still refer to the right FABs afterwards.
+
+namespace {
+
+constexpr Real old_offset = 1000;
+constexpr Real new_offset = 2000;
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real value (int i, int j, int k, int n)
+{
+    return Real(i) + Real(0.1)*Real(j) + Real(0.01)*Real(k) + Real(0.5)*Real(n);
+}
+
+void fill (MultiFab& mf, Real offset)
+{
+    auto const& ma = mf.arrays();
+    ParallelFor(mf, mf.nGrowVect(), mf.nComp(),
+    [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n)
+    {
+        ma[b](i,j,k,n) = value(i,j,k,n) + offset;
+    });
+    Gpu::streamSynchronize();
+}
+
+// The number of cells of ma that differ from expected(b), where b is the
+// local box index
+template <typename MA, typename E>
+Long count_wrong (MultiFab const& mf, MA const& ma, E const& expected)
+{
+    const int ncomp = mf.nComp();
+    Long nwrong = ParReduce(TypeList<ReduceOpSum>{}, TypeList<Long>{}, mf, mf.nGrowVect(),
+    [=] AMREX_GPU_DEVICE (int b, int i, int j, int k) noexcept -> GpuTuple<Long>
+    {
+        Long r = 0;
+        for (int n = 0; n < ncomp; ++n) {
+            if (ma[b](i,j,k,n) != expected(b,i,j,k,n)) { ++r; }
+        }
+        return { r };
+    });
+    ParallelDescriptor::ReduceLongSum(nwrong);
+    return nwrong;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        Box const domain(IntVect(0), IntVect(31));
+        BoxArray old_ba(domain);
+        old_ba.maxSize(16);
+        DistributionMapping old_dm(old_ba);
+
+        // Keep the boxes in the lower half in x with the same owners, and
+        // chop the others into smaller boxes.
+        const int nprocs = ParallelDescriptor::NProcs();
+        BoxList bl;
+        Vector<int> pmap;
+        for (int i = 0; i < old_ba.size(); ++i) {
+            if (old_ba[i].smallEnd(0) < 16) {
+                bl.push_back(old_ba[i]);
+                pmap.push_back(old_dm[i]);
+            } else {
+                BoxArray chopped(old_ba[i]);
+                chopped.maxSize(8);
+                for (int j = 0; j < chopped.size(); ++j) {
+                    bl.push_back(chopped[j]);
+                    pmap.push_back((i+j) % nprocs);
+                }
+            }
+        }
+        BoxArray const ba(std::move(bl));
+        DistributionMapping const dm(std::move(pmap));
+
+        const int ncomp = 2;
+        const IntVect ngrow(2);
+        MultiFab old_mf(old_ba, old_dm, ncomp, ngrow);
+        fill(old_mf, old_offset);
+        MultiFab mf(ba, dm, ncomp, ngrow);
+        mf.setVal(-1);
+
+        // whether the box of local index b of mf is kept from old_mf
+        Gpu::DeviceVector<int> kept_v(mf.local_size());
+        {
+            Gpu::HostVector<int> kept_h(mf.local_size());
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                kept_h[mfi.LocalIndex()] = (mfi.validbox().smallEnd(0) < 16);
+            }
+            Gpu::copy(Gpu::hostToDevice, kept_h.begin(), kept_h.end(), kept_v.begin());
+        }
+        int const* kept = kept_v.data();
+
+        auto const ma = mf.arrays();
+        auto const old_ma = old_mf.const_arrays();
+
+        FillPatchIncremental(mf, old_mf, [] (MultiFab& dst) { fill(dst, new_offset); });
+
+        auto expected = [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n) -> Real
+        {
+            return value(i,j,k,n) + (kept[b] ? old_offset : new_offset);
+        };
+
+        const Long nwrong = count_wrong(mf, mf.const_arrays(), expected);
+        const Long nwrong_before = count_wrong(mf, ma, expected);
+        amrex::Print() << "FillPatchIncremental: " << nwrong << " wrong values, "
+                       << nwrong_before << " through arrays obtained before\n";
+        AMREX_ALWAYS_ASSERT(nwrong == 0 && nwrong_before == 0);
+
+        // The FABs of old_mf that were moved now hold the old data of mf
+        Gpu::DeviceVector<int> moved_v(old_mf.local_size());
+        {
+            Gpu::HostVector<int> moved_h(old_mf.local_size());
+            for (MFIter mfi(old_mf); mfi.isValid(); ++mfi) {
+                moved_h[mfi.LocalIndex()] = (mfi.validbox().smallEnd(0) < 16);
+            }
+            Gpu::copy(Gpu::hostToDevice, moved_h.begin(), moved_h.end(), moved_v.begin());
+        }
+        int const* moved = moved_v.data();
+
+        auto expected_old = [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n) -> Real
+        {
+            return moved[b] ? Real(-1) : value(i,j,k,n) + old_offset;
+        };
+        AMREX_ALWAYS_ASSERT(count_wrong(old_mf, old_mf.const_arrays(), expected_old) == 0);
+        AMREX_ALWAYS_ASSERT(count_wrong(old_mf, old_ma, expected_old) == 0);
+
+        amrex::Print() << "pass\n";
+    }
+    amrex::Finalize();
+}
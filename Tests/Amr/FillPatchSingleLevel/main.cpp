@@ -0,0 +1,129 @@
+#include <AMReX.H>
+#include <AMReX_FillPatchUtil.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParReduce.H>
+#include <AMReX_PhysBCFunct.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+// With two source times and a destination on another BoxArray,
+// FillPatchSingleLevel interpolates in time only where the data are copied.
+// Compare it with interpolating the whole source level and then copying.
+
+namespace {
+
+// The reference: interpolate all of the source boxes in time, then copy
+void fill_reference (MultiFab& mf, IntVect const& nghost, Real time,
+                     Vector<MultiFab*> const& smf, Vector<Real> const& stime,
+                     int scomp, int dcomp, int ncomp, Geometry const& geom)
+{
+    MultiFab tmp(smf[0]->boxArray(), smf[0]->DistributionMap(), ncomp, 0);
+    const Real t0 = stime[0];
+    const Real t1 = stime[1];
+    for (MFIter mfi(tmp); mfi.isValid(); ++mfi) {
+        auto const& s0 = smf[0]->const_array(mfi);
+        auto const& s1 = smf[1]->const_array(mfi);
+        auto const& d = tmp.array(mfi);
+        if (time == t0) {
+            ParallelFor(mfi.validbox(), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                d(i,j,k,n) = s0(i,j,k,n+scomp);
+            });
+        } else if (time == t1) {
+            ParallelFor(mfi.validbox(), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                d(i,j,k,n) = s1(i,j,k,n+scomp);
+            });
+        } else {
+            Real alpha = (t1-time)/(t1-t0);
+            Real beta = (time-t0)/(t1-t0);
+            ParallelFor(mfi.validbox(), ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                d(i,j,k,n) = alpha*s0(i,j,k,n+scomp) + beta*s1(i,j,k,n+scomp);
+            });
+        }
+    }
+    mf.ParallelCopy(tmp, 0, dcomp, ncomp, IntVect(0), nghost, geom.periodicity());
+}
+
+void fill_source (MultiFab& mf, Real t)
+{
+    auto const& ma = mf.arrays();
+    ParallelFor(mf, mf.nGrowVect(), mf.nComp(),
+    [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n)
+    {
+        ma[b](i,j,k,n) = std::sin(Real(0.3)*i + Real(0.7)*j + Real(1.1)*k + Real(0.5)*n)
+            + Real(0.25)*Real(b) + t*std::cos(Real(0.2)*i*j + Real(0.1)*k);
+    });
+    Gpu::streamSynchronize();
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    // uninitialized data are NaN, so that cells that are not interpolated show up
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, [] () {
+        ParmParse pp("amrex");
+        pp.add("init_snan", 1);
+    });
+    {
+        // periodic in all but the last direction
+        Box const domain(IntVect(0), IntVect(31));
+        RealBox const rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+        is_per[AMREX_SPACEDIM-1] = 0;
+        Geometry const geom(domain, rb, CoordSys::cartesian, is_per);
+
+        BoxArray sba(domain);
+        sba.maxSize(8);
+        DistributionMapping const sdm(sba);
+
+        // Destination boxes that straddle the source boxes and touch the
+        // domain boundaries
+        BoxArray dba(Box(IntVect(AMREX_D_DECL(0,3,5)), IntVect(AMREX_D_DECL(26,31,29))));
+        dba.maxSize(IntVect(AMREX_D_DECL(11,7,10)));
+        DistributionMapping const ddm(dba);
+
+        const int ncomp = 2;
+        const int scomp = 1;
+        const int dcomp = 2;
+        const IntVect nghost(AMREX_D_DECL(2,1,3));
+
+        MultiFab s0(sba, sdm, ncomp+scomp, 0);
+        MultiFab s1(sba, sdm, ncomp+scomp, 0);
+        fill_source(s0, Real(0.0));
+        fill_source(s1, Real(1.0));
+        Vector<MultiFab*> const smf{&s0, &s1};
+        Vector<Real> const stime{Real(0.5), Real(1.5)};
+
+        PhysBCFunctNoOp physbc;
+
+        for (Real time : {Real(0.5), Real(0.8), Real(1.5)}) {
+            MultiFab mf(dba, ddm, ncomp+dcomp, nghost);
+            MultiFab ref(dba, ddm, ncomp+dcomp, nghost);
+            mf.setVal(-7);
+            ref.setVal(-7);
+            FillPatchSingleLevel(mf, nghost, time, smf, stime, scomp, dcomp, ncomp, geom, physbc, 0);
+            fill_reference(ref, nghost, time, smf, stime, scomp, dcomp, ncomp, geom);
+
+            // a NaN from uninitialized data also counts as a difference
+            auto const& ma = mf.const_arrays();
+            auto const& ra = ref.const_arrays();
+            Long ndiff = ParReduce(TypeList<ReduceOpSum>{}, TypeList<Long>{}, mf, nghost,
+                                   ncomp+dcomp,
+            [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n) noexcept -> GpuTuple<Long>
+            {
+                return { !(ma[b](i,j,k,n) == ra[b](i,j,k,n)) };
+            });
+            ParallelDescriptor::ReduceLongSum(ndiff);
+            amrex::Print() << "time " << time << ": " << ndiff << " values differ\n";
+            AMREX_ALWAYS_ASSERT(ndiff == 0);
+        }
+
+        amrex::Print() << "pass\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,243 @@
+#include <AMReX.H>
+#include <AMReX_FluxRegister.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+#include <AMReX_YAFluxRegister.H>
+
+#include <limits>
+
+using namespace amrex;
+
+// Compare the batched CrseInit, CrseAdd, FineAdd and BatchedReflux of
+// FluxRegister with the per-direction versions and Reflux, and
+// BatchedReflux with mask_covered with YAFluxRegister.
+
+namespace {
+
+// Periodic with a period of 32 cells, so that the fluxes on the faces across
+// the periodic boundaries agree on both levels.
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real flux_value (int i, int j, int k, int dir, int n, Real scale)
+{
+    amrex::ignore_unused(j,k);
+    constexpr Real w = Real(2.0)*Math::pi<Real>()/Real(32.0);
+    return scale * (Real(1.0) + Real(0.1)*dir + Real(0.01)*n
+                    + std::sin(w*Real(3*i AMREX_D_TERM(, + 7*j, + 11*k))));
+}
+
+void fill_flux (Array<MultiFab,AMREX_SPACEDIM>& flux, Real scale)
+{
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        auto const& ma = flux[dir].arrays();
+        ParallelFor(flux[dir], IntVect(0), flux[dir].nComp(),
+        [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n)
+        {
+            ma[b](i,j,k,n) = flux_value(i,j,k,dir,n,scale);
+        });
+    }
+}
+
+Array<MultiFab const*,AMREX_SPACEDIM> const_ptrs (Array<MultiFab,AMREX_SPACEDIM> const& a)
+{
+    return {AMREX_D_DECL(&a[0], &a[1], &a[2])};
+}
+
+Real max_diff (MultiFab const& a, MultiFab const& b)
+{
+    MultiFab diff(a.boxArray(), a.DistributionMap(), a.nComp(), 0);
+    MultiFab::LinComb(diff, Real(1.0), a, 0, Real(-1.0), b, 0, 0, a.nComp(), 0);
+    return diff.norm0(0, a.nComp(), IntVect(0));
+}
+
+struct Level
+{
+    Geometry geom;
+    BoxArray ba;
+    DistributionMapping dm;
+    Array<MultiFab,AMREX_SPACEDIM> flux;
+    Array<MultiFab,AMREX_SPACEDIM> area;
+    MultiFab volume;
+
+    Level (Geometry const& a_geom, BoxArray const& a_ba, int ncomp)
+        : geom(a_geom), ba(a_ba), dm(a_ba)
+    {
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            flux[dir].define(amrex::convert(ba, IntVect::TheDimensionVector(dir)), dm, ncomp, 0);
+            geom.GetFaceArea(area[dir], ba, dm, dir, 0);
+        }
+        geom.GetVolume(volume, ba, dm, 0);
+    }
+};
+
+// Apply the flux corrections of a fine level to a coarse state with the
+// per-direction and with the batched functions, and return the maximum
+// difference relative to the maximum correction.
+Real compare (FluxRegister& fr, FluxRegister& fr_batched, Level& crse, Level& fine,
+              int ncomp, bool use_crse_add, bool use_area)
+{
+    fill_flux(crse.flux, Real(1.0));
+    fill_flux(fine.flux, Real(0.25));
+
+    MultiFab state(crse.ba, crse.dm, ncomp, 0);
+    state.setVal(0.0);
+    MultiFab state_batched(crse.ba, crse.dm, ncomp, 0);
+    state_batched.setVal(0.0);
+
+    fr.setVal(0.0);
+    fr_batched.setVal(0.0);
+
+    Array<MultiFab const*,AMREX_SPACEDIM> no_area{AMREX_D_DECL(nullptr,nullptr,nullptr)};
+    auto const& crse_area = use_area ? const_ptrs(crse.area) : no_area;
+    auto const& fine_area = use_area ? const_ptrs(fine.area) : no_area;
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        if (use_crse_add) {
+            if (use_area) {
+                fr.CrseAdd(crse.flux[dir], crse.area[dir], dir, 0, 0, ncomp, -1.0, crse.geom);
+            } else {
+                fr.CrseAdd(crse.flux[dir], dir, 0, 0, ncomp, -1.0, crse.geom);
+            }
+        } else {
+            if (use_area) {
+                fr.CrseInit(crse.flux[dir], crse.area[dir], dir, 0, 0, ncomp);
+            } else {
+                fr.CrseInit(crse.flux[dir], dir, 0, 0, ncomp);
+            }
+        }
+        if (use_area) {
+            fr.FineAdd(fine.flux[dir], fine.area[dir], dir, 0, 0, ncomp, 1.0);
+        } else {
+            fr.FineAdd(fine.flux[dir], dir, 0, 0, ncomp, 1.0);
+        }
+    }
+    if (use_area) {
+        fr.Reflux(state, crse.volume, 1.0, 0, 0, ncomp, crse.geom);
+    } else {
+        fr.Reflux(state, 1.0, 0, 0, ncomp, crse.geom);
+    }
+
+    if (use_crse_add) {
+        fr_batched.CrseAdd(const_ptrs(crse.flux), crse_area, 0, 0, ncomp, -1.0, crse.geom);
+    } else {
+        fr_batched.CrseInit(const_ptrs(crse.flux), crse_area, 0, 0, ncomp);
+    }
+    fr_batched.FineAdd(const_ptrs(fine.flux), fine_area, 0, 0, ncomp, 1.0);
+    if (use_area) {
+        fr_batched.BatchedReflux(state_batched, crse.volume, 1.0, 0, 0, ncomp, crse.geom);
+    } else {
+        fr_batched.BatchedReflux(state_batched, 1.0, 0, 0, ncomp, crse.geom);
+    }
+
+    Real const corr = state.norm0(0, ncomp, IntVect(0));
+    AMREX_ALWAYS_ASSERT(corr > Real(0.0));
+    return max_diff(state, state_batched) / corr;
+}
+
+// Apply the flux corrections of a fine level to a coarse state with
+// BatchedReflux and with YAFluxRegister, which leaves the coarse cells
+// covered by the fine level alone, and return the maximum difference
+// relative to the maximum correction.
+Real compare_ya (FluxRegister& fr, Level& crse, Level& fine, IntVect const& ratio,
+                 int ncomp, bool mask_covered)
+{
+    Real const dt = 0.1;
+    fill_flux(crse.flux, Real(1.0));
+    fill_flux(fine.flux, Real(0.25));
+
+    MultiFab state(crse.ba, crse.dm, ncomp, 0);
+    state.setVal(0.0);
+    MultiFab state_ya(crse.ba, crse.dm, ncomp, 0);
+    state_ya.setVal(0.0);
+
+    fr.setVal(0.0);
+    fr.CrseInit(const_ptrs(crse.flux), const_ptrs(crse.area), 0, 0, ncomp, -dt);
+    fr.FineAdd(const_ptrs(fine.flux), const_ptrs(fine.area), 0, 0, ncomp, dt);
+    fr.BatchedReflux(state, crse.volume, 1.0, 0, 0, ncomp, crse.geom, mask_covered);
+
+    YAFluxRegister ya(fine.ba, crse.ba, fine.dm, crse.dm, fine.geom, crse.geom, ratio, 1, ncomp);
+    ya.reset();
+    for (MFIter mfi(crse.volume); mfi.isValid(); ++mfi) {
+        std::array<FArrayBox const*,AMREX_SPACEDIM> flux{{AMREX_D_DECL(&crse.flux[0][mfi],
+                                                                       &crse.flux[1][mfi],
+                                                                       &crse.flux[2][mfi])}};
+        ya.CrseAdd(mfi, flux, crse.geom.CellSize(), dt, RunOn::Gpu);
+    }
+    for (MFIter mfi(fine.volume); mfi.isValid(); ++mfi) {
+        std::array<FArrayBox const*,AMREX_SPACEDIM> flux{{AMREX_D_DECL(&fine.flux[0][mfi],
+                                                                       &fine.flux[1][mfi],
+                                                                       &fine.flux[2][mfi])}};
+        ya.FineAdd(mfi, flux, fine.geom.CellSize(), dt, RunOn::Gpu);
+    }
+    ya.Reflux(state_ya);
+
+    Real const corr = state_ya.norm0(0, ncomp, IntVect(0));
+    AMREX_ALWAYS_ASSERT(corr > Real(0.0));
+    return max_diff(state, state_ya) / corr;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        constexpr int ncomp = 2;
+        constexpr int n_cell = 32;
+        IntVect const ratio(2);
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry crse_geom(Box(IntVect(0), IntVect(n_cell-1)), rb, CoordSys::cartesian,
+                           is_periodic);
+        Geometry fine_geom = amrex::refine(crse_geom, ratio);
+
+        BoxArray crse_ba(crse_geom.Domain());
+        crse_ba.maxSize(16);
+        Level crse(crse_geom, crse_ba, ncomp);
+
+        // Two fine patches, one of them touching the periodic boundary.
+        BoxArray fine_ba1(BoxList(Vector<Box>{
+            Box(IntVect(8), IntVect(23)).refine(ratio),
+            Box(IntVect(AMREX_D_DECL(24,0,0)), IntVect(AMREX_D_DECL(31,7,7))).refine(ratio)}));
+        fine_ba1.maxSize(16);
+        Level fine1(fine_geom, fine_ba1, ncomp);
+
+        BoxArray fine_ba2(Box(IntVect(AMREX_D_DECL(0,8,16)),
+                              IntVect(AMREX_D_DECL(15,23,31))).refine(ratio));
+        fine_ba2.maxSize(8);
+        Level fine2(fine_geom, fine_ba2, ncomp);
+
+        FluxRegister fr(fine1.ba, fine1.dm, ratio, 1, ncomp);
+        FluxRegister fr_batched(fine1.ba, fine1.dm, ratio, 1, ncomp);
+
+        Real const tol = Real(1000)*std::numeric_limits<Real>::epsilon();
+        for (bool use_crse_add : {false, true}) {
+            for (bool use_area : {false, true}) {
+                Real err = compare(fr, fr_batched, crse, fine1, ncomp, use_crse_add, use_area);
+                amrex::Print() << (use_crse_add ? "CrseAdd" : "CrseInit")
+                               << (use_area ? " with area" : " without area")
+                               << ": relative difference " << err << "\n";
+                AMREX_ALWAYS_ASSERT(err < tol);
+            }
+        }
+
+        // The fine boxes are adjacent, so without the mask the corrections at
+        // the faces between them end up in covered coarse cells.
+        for (bool mask_covered : {false, true}) {
+            Real err = compare_ya(fr_batched, crse, fine1, ratio, ncomp, mask_covered);
+            amrex::Print() << "BatchedReflux" << (mask_covered ? " with" : " without")
+                           << " mask_covered vs YAFluxRegister: relative difference " << err << "\n";
+            AMREX_ALWAYS_ASSERT(mask_covered ? err < tol : err > Real(0.1));
+        }
+
+        // Redefine the registers on different fine grids.
+        fr.clear();
+        fr.define(fine2.ba, fine2.dm, ratio, 1, ncomp);
+        fr_batched.clear();
+        fr_batched.define(fine2.ba, fine2.dm, ratio, 1, ncomp);
+        Real err = compare(fr, fr_batched, crse, fine2, ncomp, false, true);
+        amrex::Print() << "Redefined: relative difference " << err << "\n";
+        AMREX_ALWAYS_ASSERT(err < tol);
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,169 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Interpolater.H>
+#include <AMReX_MFInterpolater.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <limits>
+
+using namespace amrex;
+
+namespace {
+
+// Exact cell average of sin(2 pi x) sin(2 pi y) sin(2 pi z)
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real smooth_average (int i, int j, int k, Real dx)
+{
+    constexpr Real tpi = Real(2.0)*Math::pi<Real>();
+    auto f = [=] (int ii) {
+        return (std::cos(tpi*Real(ii)*dx) - std::cos(tpi*Real(ii+1)*dx)) / (tpi*dx);
+    };
+    return AMREX_D_TERM(f(i),*f(j),*f(k));
+}
+
+// A step in x with a cell face at 1/3 of the coarse domain
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real step_average (int i, int ncell)
+{
+    return (3*i < ncell) ? Real(1.0) : Real(0.0);
+}
+
+struct Result
+{
+    Real err = 0;  // max error against the exact fine averages
+    Real cons = 0; // max conservation error
+    Real fmin = 0;
+    Real fmax = 0;
+};
+
+Result test (Interpolater& interp, int n_cell, int max_grid_size, bool smooth, int nrep,
+             double& time)
+{
+    Box cdomain(IntVect(0), IntVect(n_cell-1));
+    Box fdomain = amrex::refine(cdomain, 2);
+    RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+    Geometry cgeom(cdomain, rb, CoordSys::cartesian, is_periodic);
+    Geometry fgeom(fdomain, rb, CoordSys::cartesian, is_periodic);
+
+    BoxArray fba(fdomain);
+    fba.maxSize(max_grid_size);
+    DistributionMapping dm(fba);
+    BoxArray cba = amrex::coarsen(fba, 2);
+
+    MultiFab crse(cba, dm, 1, 2);
+    MultiFab fine(fba, dm, 1, 0);
+    MultiFab fine2(fba, dm, 1, 0);
+
+    const Real cdx = Real(1.0)/Real(n_cell);
+    auto const& ca = crse.arrays();
+    ParallelFor(crse, IntVect(0), [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+    {
+        ca[b](i,j,k) = smooth ? smooth_average(i,j,k,cdx) : step_average(i,n_cell);
+    });
+    crse.FillBoundary(cgeom.periodicity());
+
+    Vector<BCRec> bcr(1, BCRec(AMREX_D_DECL(BCType::int_dir,BCType::int_dir,BCType::int_dir),
+                               AMREX_D_DECL(BCType::int_dir,BCType::int_dir,BCType::int_dir)));
+
+    auto t0 = amrex::second();
+    for (int irep = 0; irep < nrep; ++irep) {
+        for (MFIter mfi(fine); mfi.isValid(); ++mfi) {
+            interp.interp(crse[mfi], 0, fine[mfi], 0, 1, mfi.validbox(), IntVect(2),
+                          cgeom, fgeom, bcr, 0, 0, RunOn::Device);
+        }
+    }
+    Gpu::streamSynchronize();
+    time = (amrex::second() - t0) / nrep;
+    ParallelDescriptor::ReduceRealMax(time);
+
+    // The MultiFab version must give the same answer.
+    MFInterpolater* mfinterp = nullptr;
+    if (&interp == &weno5_interp) {
+        mfinterp = &mf_weno5_interp;
+    } else if (&interp == &mp5_interp) {
+        mfinterp = &mf_mp5_interp;
+    }
+    if (mfinterp) {
+        mfinterp->interp(crse, 0, fine2, 0, 1, IntVect(0), cgeom, fgeom, fdomain,
+                         IntVect(2), bcr, 0);
+        MultiFab::Subtract(fine2, fine, 0, 0, 1, 0);
+        AMREX_ALWAYS_ASSERT(fine2.norm0() == Real(0.0));
+    }
+
+    Result r;
+    auto const& fa = fine.const_arrays();
+    auto const& cca = crse.const_arrays();
+    const Real fdx = cdx*Real(0.5);
+    r.err = ParReduce(TypeList<ReduceOpMax>{}, TypeList<Real>{}, fine, IntVect(0),
+    [=] AMREX_GPU_DEVICE (int b, int i, int j, int k) -> GpuTuple<Real>
+    {
+        Real exact = smooth ? smooth_average(i,j,k,fdx) : step_average(i,2*n_cell);
+        return { std::abs(fa[b](i,j,k) - exact) };
+    });
+    r.cons = ParReduce(TypeList<ReduceOpMax>{}, TypeList<Real>{}, crse, IntVect(0),
+    [=] AMREX_GPU_DEVICE (int b, int i, int j, int k) -> GpuTuple<Real>
+    {
+        Real avg = 0;
+        for (int kk = 0; kk < AMREX_D_PICK(1,1,2); ++kk) {
+        for (int jj = 0; jj < AMREX_D_PICK(1,2,2); ++jj) {
+        for (int ii = 0; ii < 2; ++ii) {
+            avg += fa[b](2*i+ii,AMREX_D_PICK(0,2*j+jj,2*j+jj),AMREX_D_PICK(0,0,2*k+kk));
+        }}}
+        avg /= Real(AMREX_D_TERM(2,*2,*2));
+        return { std::abs(avg - cca[b](i,j,k)) };
+    });
+    ParallelDescriptor::ReduceRealMax({r.err, r.cons});
+    r.fmin = fine.min(0);
+    r.fmax = fine.max(0);
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        int nrep = 4;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nrep", nrep);
+        }
+
+        Vector<std::pair<std::string,Interpolater*>> interps
+            {{"cell_cons", &cell_cons_interp},
+             {"quartic  ", &quartic_interp},
+             {"weno5    ", &weno5_interp},
+             {"mp5      ", &mp5_interp}};
+
+        for (auto const& [name, interp] : interps) {
+            double time1, time2, time3;
+            Result r1 = test(*interp, n_cell  , max_grid_size, true , nrep, time1);
+            Result r2 = test(*interp, n_cell*2, max_grid_size, true , 1   , time2);
+            Result r3 = test(*interp, n_cell  , max_grid_size, false, 1   , time3);
+            Real order = std::log2(r1.err/r2.err);
+            amrex::Print() << name << ": smooth error " << r1.err << " -> " << r2.err
+                           << ", order " << order
+                           << ", conservation error " << std::max(r1.cons, r2.cons)
+                           << ", step range [" << r3.fmin << ", " << r3.fmax << "]"
+                           << ", time " << time1 << "\n";
+
+            AMREX_ALWAYS_ASSERT(std::max({r1.cons,r2.cons,r3.cons}) <
+                                Real(1000)*std::numeric_limits<Real>::epsilon());
+            if (interp == &weno5_interp || interp == &quartic_interp) {
+                AMREX_ALWAYS_ASSERT(order > Real(4.5));
+            }
+            if (interp == &mp5_interp) {
+                AMREX_ALWAYS_ASSERT(order > Real(4.5));
+                AMREX_ALWAYS_ASSERT(r3.fmin >= Real(0.0) && r3.fmax <= Real(1.0));
+            }
+        }
+    }
+    amrex::Finalize();
+}
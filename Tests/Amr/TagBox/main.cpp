@@ -0,0 +1,173 @@
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_TagBox.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+// Compare TagBoxArray::buffer and TagBoxArray::collate with brute force
+// references on random tags, including tags in ghost cells and tags touching
+// the box and domain edges.
+
+namespace {
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+unsigned int hash (int i, int j, int k, int b)
+{
+    auto h = static_cast<unsigned int>(i)*73856093U ^ static_cast<unsigned int>(j)*19349663U
+        ^ static_cast<unsigned int>(k)*83492791U ^ static_cast<unsigned int>(b)*2654435761U;
+    h ^= h >> 13;
+    h *= 0x5bd1e995U;
+    h ^= h >> 15;
+    return h;
+}
+
+// The initial tag of cell (i,j,k) of box b, valid or ghost
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+char initial_tag (int i, int j, int k, int b, Box const& vbox, Box const& domain)
+{
+    IntVect const iv(AMREX_D_DECL(i,j,k));
+    bool corner = true;
+    bool on_domain_edge = false;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        corner = corner && (iv[idim] == vbox.smallEnd(idim) || iv[idim] == vbox.bigEnd(idim));
+        on_domain_edge = on_domain_edge || iv[idim] == domain.smallEnd(idim)
+            || iv[idim] == domain.bigEnd(idim);
+    }
+    if (corner ||
+        (on_domain_edge && hash(i,j,k,b) % 5 == 0) ||
+        hash(i >> 2, j, k, b) % 29 == 0 || // runs in x
+        hash(i,j,k,b) % 97 == 0)
+    {
+        return TagBox::SET;
+    } else if (hash(i,j,k,b+7) % 101 == 0) {
+        return TagBox::BUF;
+    } else {
+        return TagBox::CLEAR;
+    }
+}
+
+// A CLEAR cell becomes BUF if there is a SET cell of the interior within nbuf
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+char buffered_tag (int i, int j, int k, int b, Box const& vbox, Box const& domain,
+                   Box const& interior, IntVect const& nbuf)
+{
+    char t = initial_tag(i,j,k,b,vbox,domain);
+    if (t != TagBox::CLEAR) { return t; }
+    IntVect const iv(AMREX_D_DECL(i,j,k));
+    Box const nbhd = Box(iv-nbuf, iv+nbuf) & interior;
+    if (nbhd.ok()) {
+        auto const lo = amrex::lbound(nbhd);
+        auto const hi = amrex::ubound(nbhd);
+        for (int kk = lo.z; kk <= hi.z; ++kk) {
+        for (int jj = lo.y; jj <= hi.y; ++jj) {
+        for (int ii = lo.x; ii <= hi.x; ++ii) {
+            if (initial_tag(ii,jj,kk,b,vbox,domain) == TagBox::SET) { return TagBox::BUF; }
+        }}}
+    }
+    return t;
+}
+
+void fill_tags (TagBoxArray& tba, Box const& domain)
+{
+    for (MFIter mfi(tba); mfi.isValid(); ++mfi) {
+        auto const& a = tba.array(mfi);
+        const int b = mfi.index();
+        Box const vbox = mfi.validbox();
+        ParallelFor(mfi.fabbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            a(i,j,k) = initial_tag(i,j,k,b,vbox,domain);
+        });
+    }
+}
+
+Long count_wrong_tags (TagBoxArray const& tba, Box const& domain, IntVect const& nbuf)
+{
+    ReduceOps<ReduceOpSum> reduce_op;
+    ReduceData<Long> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    for (MFIter mfi(tba); mfi.isValid(); ++mfi) {
+        auto const& a = tba.const_array(mfi);
+        const int b = mfi.index();
+        Box const vbox = mfi.validbox();
+        Box const interior = amrex::grow(mfi.fabbox(), -tba.nGrowVect());
+        reduce_op.eval(mfi.fabbox(), reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            return { a(i,j,k) != buffered_tag(i,j,k,b,vbox,domain,interior,nbuf) };
+        });
+    }
+    Long nwrong = amrex::get<0>(reduce_data.value());
+    ParallelDescriptor::ReduceLongSum(nwrong);
+    return nwrong;
+}
+
+bool iv_less (IntVect const& a, IntVect const& b)
+{
+    for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+        if (a[idim] != b[idim]) { return a[idim] < b[idim]; }
+    }
+    return false;
+}
+
+// All the non-CLEAR cells of all the boxes, ghost cells included
+Vector<IntVect> expected_collate (BoxArray const& ba, IntVect const& ngrow, Box const& domain,
+                                  IntVect const& nbuf)
+{
+    Vector<IntVect> r;
+    for (int b = 0; b < ba.size(); ++b) {
+        Box const vbox = ba[b];
+        Box const fbox = amrex::grow(vbox, ngrow);
+        Box const interior = vbox;
+        amrex::LoopOnCpu(fbox, [&] (int i, int j, int k)
+        {
+            if (buffered_tag(i,j,k,b,vbox,domain,interior,nbuf) != TagBox::CLEAR) {
+                r.push_back(IntVect(AMREX_D_DECL(i,j,k)));
+            }
+        });
+    }
+    std::sort(r.begin(), r.end(), iv_less);
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        // Boxes longer than 64 cells in x span several words of the bitmask
+        Box const domain(IntVect(0), IntVect(AMREX_D_DECL(159,31,23)));
+        BoxArray ba(domain);
+        ba.maxSize(IntVect(AMREX_D_DECL(96,16,16)));
+        DistributionMapping dm(ba);
+        IntVect const ngrow(3);
+
+        Vector<IntVect> nbufs{IntVect(0), IntVect(1), IntVect(2), IntVect(3),
+                              IntVect(AMREX_D_DECL(1,2,3)), IntVect(AMREX_D_DECL(3,0,2))};
+
+        for (auto const& nbuf : nbufs) {
+            TagBoxArray tba(ba, dm, ngrow);
+            fill_tags(tba, domain);
+            tba.buffer(nbuf);
+            const Long nwrong = count_wrong_tags(tba, domain, nbuf);
+            amrex::Print() << "buffer " << nbuf << ": " << nwrong << " wrong tags\n";
+            AMREX_ALWAYS_ASSERT(nwrong == 0);
+
+            Gpu::PinnedVector<IntVect> tags;
+            tba.collate(tags);
+            if (ParallelDescriptor::IOProcessor()) {
+                Vector<IntVect> v(tags.begin(), tags.end());
+                std::sort(v.begin(), v.end(), iv_less);
+                auto const expected = expected_collate(ba, ngrow, domain, nbuf);
+                amrex::Print() << "collate " << nbuf << ": " << v.size() << " tags\n";
+                AMREX_ALWAYS_ASSERT(!v.empty() && v == expected);
+            }
+        }
+
+        amrex::Print() << "pass\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,141 @@
+#include <AMReX.H>
+#include <AMReX_AmrTaskGraph.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace amrex;
+
+// Check that the tasks of AmrTaskGraph run, and that they run after their
+// dependencies, for synchronous and asynchronous tasks.
+
+namespace {
+
+struct Log
+{
+    std::mutex mutex;
+    std::vector<std::string> names;
+
+    void add (std::string const& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        names.push_back(name);
+    }
+
+    int position (std::string const& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0, N = static_cast<int>(names.size()); i < N; ++i) {
+            if (names[i] == name) { return i; }
+        }
+        return -1;
+    }
+};
+
+// Lets one task wait until another one has run.
+struct Gate
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool is_open = false;
+
+    void open () {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_open = true;
+        }
+        cv.notify_all();
+    }
+
+    // Returns false if the gate is still closed after a minute.
+    bool wait () {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(60), [&] { return is_open; });
+    }
+};
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        Log log;
+        AmrTaskGraph graph;
+        graph.setTrace(true);
+
+        AMREX_ALWAYS_ASSERT(graph.lastTask() == -1);
+
+        // Synchronous tasks run as soon as they are added.
+        int a = graph.addTask("a", 0, [&] () { log.add("a"); });
+        AMREX_ALWAYS_ASSERT(a == 0 && graph.isDone(a) && log.position("a") == 0);
+
+        // Asynchronous tasks run after their dependencies, in order.  b
+        // cannot finish before d has run.
+        Gate gate;
+        bool gate_opened = false;
+        int b = graph.addTask("b", 0, [&] () { gate_opened = gate.wait(); log.add("b"); }, {a}, true);
+        int c = graph.addTask("c", 1, [&] () { log.add("c"); }, {b}, true);
+        AMREX_ALWAYS_ASSERT(graph.lastTask() == c);
+
+        // A synchronous task without dependencies does not wait for the
+        // asynchronous ones.
+        int d = graph.addTask("d", 1, [&] () { log.add("d"); gate.open(); });
+        AMREX_ALWAYS_ASSERT(graph.isDone(d));
+
+        // A synchronous task waits for its asynchronous dependencies.
+        int e = graph.addTask("e", -1, [&] () { log.add("e"); }, {c});
+        AMREX_ALWAYS_ASSERT(graph.isDone(b) && graph.isDone(c) && graph.isDone(e));
+        AMREX_ALWAYS_ASSERT(gate_opened);
+        AMREX_ALWAYS_ASSERT(log.position("b") < log.position("c"));
+        AMREX_ALWAYS_ASSERT(log.position("c") < log.position("e"));
+        AMREX_ALWAYS_ASSERT(log.position("d") < log.position("b"));
+
+        // An asynchronous task waits for its synchronous dependencies, and
+        // wait() returns once it is done.
+        int f = graph.addTask("f", 2, [&] () { log.add("f"); }, {e}, true);
+        graph.wait(f);
+        AMREX_ALWAYS_ASSERT(graph.isDone(f));
+        AMREX_ALWAYS_ASSERT(log.position("e") < log.position("f"));
+
+        // Ids keep increasing after clear, and cleared tasks are done.
+        graph.addTask("g", 2, [&] () { log.add("g"); }, {}, true);
+        graph.clear();
+        AMREX_ALWAYS_ASSERT(graph.isDone(f));
+        int h = graph.addTask("h", 0, [&] () { log.add("h"); }, {f});
+        AMREX_ALWAYS_ASSERT(h == f+2 && graph.isDone(h));
+
+        // Names are escaped in the trace.
+        std::string const odd_name = "say \"hi\"\\\n";
+        graph.addTask(odd_name, -1, [&] () { log.add("odd"); });
+        graph.finish();
+
+        AMREX_ALWAYS_ASSERT(log.names.size() == 9);
+
+        // Every task is in the trace.
+        std::string const trace_file = "task_trace";
+        graph.writeTrace(trace_file);
+        {
+            std::ifstream ifs(amrex::Concatenate(trace_file, ParallelDescriptor::MyProc(), 5));
+            std::stringstream ss;
+            ss << ifs.rdbuf();
+            std::string const trace = ss.str();
+            for (auto const& name : log.names) {
+                if (name == "odd") { continue; }
+                AMREX_ALWAYS_ASSERT(trace.find("\"name\":\""+name+"\"") != std::string::npos);
+            }
+            AMREX_ALWAYS_ASSERT(trace.find(R"("name":"say \"hi\"\\\n")") != std::string::npos);
+        }
+
+        amrex::Print() << "Tasks ran in the order";
+        for (auto const& name : log.names) { amrex::Print() << " " << name; }
+        amrex::Print() << "\n";
+    }
+    amrex::Finalize();
+}
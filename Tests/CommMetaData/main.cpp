@@ -0,0 +1,211 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+using namespace amrex;
+
+// Write the FillBoundary and ParallelCopy metadata to
+// fabarray.comm_metadata_dir, read them back, and compare with freshly
+// built metadata.  A file written for another layout must not be used, and
+// the number of files must stay within fabarray.comm_metadata_max_files.
+
+namespace {
+
+bool same_tags (FabArrayBase::CopyComTagsContainer const& a,
+                FabArrayBase::CopyComTagsContainer const& b)
+{
+    if (a.size() != b.size()) { return false; }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].dbox != b[i].dbox || a[i].sbox != b[i].sbox ||
+            a[i].dstIndex != b[i].dstIndex || a[i].srcIndex != b[i].srcIndex) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool same_tags (FabArrayBase::MapOfCopyComTagContainers const& a,
+                FabArrayBase::MapOfCopyComTagContainers const& b)
+{
+    if (a.size() != b.size()) { return false; }
+    for (auto const& [rank, tags] : a) {
+        auto it = b.find(rank);
+        if (it == b.end() || !same_tags(tags, it->second)) { return false; }
+    }
+    return true;
+}
+
+bool same_metadata (FabArrayBase::CommMetaData const& a, FabArrayBase::CommMetaData const& b)
+{
+    bool r = same_tags(*a.m_LocTags, *b.m_LocTags)
+        &&   same_tags(*a.m_SndTags, *b.m_SndTags)
+        &&   same_tags(*a.m_RcvTags, *b.m_RcvTags)
+        &&   a.m_threadsafe_loc == b.m_threadsafe_loc
+        &&   a.m_threadsafe_rcv == b.m_threadsafe_rcv;
+    ParallelDescriptor::ReduceBoolAnd(r);
+    return r;
+}
+
+// The FB metadata of a MultiFab, built with the current settings, and the
+// results of FillBoundary and ParallelCopy.
+struct Metadata
+{
+    FabArrayBase::CommMetaData fb;
+    MultiFab fb_result;
+    MultiFab pc_result;
+};
+
+Metadata build (MultiFab const& src, MultiFab const& pc_src, IntVect const& ng,
+                Periodicity const& period)
+{
+    FabArrayBase::flushFBCache();
+    FabArrayBase::flushCPCache();
+
+    Metadata md;
+    md.fb_result.define(src.boxArray(), src.DistributionMap(), src.nComp(), ng);
+    md.fb_result.setVal(-1.0);
+    MultiFab::Copy(md.fb_result, src, 0, 0, src.nComp(), 0);
+    md.fb_result.FillBoundary(period);
+
+    md.pc_result.define(src.boxArray(), src.DistributionMap(), src.nComp(), 0);
+    md.pc_result.setVal(-1.0);
+    md.pc_result.ParallelCopy(pc_src, period);
+
+    auto const& fb = md.fb_result.getFB(ng, period);
+    md.fb.m_threadsafe_loc = fb.m_threadsafe_loc;
+    md.fb.m_threadsafe_rcv = fb.m_threadsafe_rcv;
+    md.fb.m_LocTags = std::make_unique<FabArrayBase::CopyComTagsContainer>(*fb.m_LocTags);
+    md.fb.m_SndTags = std::make_unique<FabArrayBase::MapOfCopyComTagContainers>(*fb.m_SndTags);
+    md.fb.m_RcvTags = std::make_unique<FabArrayBase::MapOfCopyComTagContainers>(*fb.m_RcvTags);
+    return md;
+}
+
+Real max_diff (MultiFab const& a, MultiFab const& b)
+{
+    MultiFab diff(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrowVect());
+    MultiFab::LinComb(diff, Real(1.0), a, 0, Real(-1.0), b, 0, 0, a.nComp(), a.nGrowVect());
+    return diff.norm0(0, a.nComp(), a.nGrowVect());
+}
+
+void check (Metadata const& a, Metadata const& b)
+{
+    AMREX_ALWAYS_ASSERT(same_metadata(a.fb, b.fb));
+    AMREX_ALWAYS_ASSERT(max_diff(a.fb_result, b.fb_result) == Real(0.0));
+    AMREX_ALWAYS_ASSERT(max_diff(a.pc_result, b.pc_result) == Real(0.0));
+}
+
+// The FillBoundary metadata files of a process in dir
+Vector<std::string> fb_files (std::string const& dir, int rank)
+{
+    std::string suffix = amrex::Concatenate("_", rank, 5);
+    Vector<std::string> files;
+    for (auto const& entry : std::filesystem::directory_iterator(dir)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("fb_", 0) == 0 && name.size() > suffix.size() &&
+            name.compare(name.size()-suffix.size(), suffix.size(), suffix) == 0) {
+            files.push_back(entry.path().string());
+        }
+    }
+    return files;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        const IntVect ng(2);
+        Geometry geom(Box(IntVect(0), IntVect(31)),
+                      RealBox(AMREX_D_DECL(0.,0.,0.), AMREX_D_DECL(1.,1.,1.)),
+                      CoordSys::cartesian, {AMREX_D_DECL(1,1,1)});
+        Periodicity const& period = geom.periodicity();
+
+        auto make_mf = [&] (int max_grid_size)
+        {
+            BoxArray ba(geom.Domain());
+            ba.maxSize(max_grid_size);
+            MultiFab mf(ba, DistributionMapping(ba), 1, 0);
+            auto const& ma = mf.arrays();
+            ParallelFor(mf, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+            {
+                ma[b](i,j,k) = Real(i) + Real(100*j) + Real(10000*k);
+            });
+            return mf;
+        };
+
+        // Two layouts for FillBoundary, and the source for ParallelCopy
+        MultiFab mfa = make_mf(8);
+        MultiFab mfa_src = make_mf(16);
+        MultiFab mfb = make_mf(16);
+
+        std::string const dir_a = "comm_metadata_a";
+        std::string const dir_b = "comm_metadata_b";
+        std::string const dir_c = "comm_metadata_c";
+
+        // Start without the files of earlier runs.
+        if (ParallelDescriptor::IOProcessor()) {
+            for (auto const& dir : {dir_a, dir_b, dir_c}) {
+                std::filesystem::remove_all(dir);
+            }
+        }
+        ParallelDescriptor::Barrier();
+
+        FabArrayBase::comm_metadata_dir.clear();
+        Metadata fresh_a = build(mfa, mfa_src, ng, period);
+        Metadata fresh_b = build(mfb, mfa_src, ng, period);
+
+        // Written, then read back.
+        FabArrayBase::comm_metadata_dir = dir_a;
+        Metadata written_a = build(mfa, mfa_src, ng, period);
+        check(fresh_a, written_a);
+        Metadata read_a = build(mfa, mfa_src, ng, period);
+        check(fresh_a, read_a);
+
+        // A file of layout b renamed to the name of layout a is rejected.
+        FabArrayBase::comm_metadata_dir = dir_b;
+        Metadata written_b = build(mfb, mfa_src, ng, period);
+        check(fresh_b, written_b);
+        ParallelDescriptor::Barrier();
+        if (ParallelDescriptor::IOProcessor()) {
+            for (int rank = 0; rank < ParallelDescriptor::NProcs(); ++rank) {
+                auto files_a = fb_files(dir_a, rank);
+                auto files_b = fb_files(dir_b, rank);
+                AMREX_ALWAYS_ASSERT(files_a.size() == 1 && files_b.size() == 1);
+                std::rename(files_b[0].c_str(), files_a[0].c_str());
+            }
+        }
+        ParallelDescriptor::Barrier();
+        FabArrayBase::comm_metadata_dir = dir_a;
+        Metadata rejected_a = build(mfa, mfa_src, ng, period);
+        check(fresh_a, rejected_a);
+
+        // With regrids, the files of older layouts are replaced.
+        FabArrayBase::comm_metadata_max_files = 2;
+        for (int max_grid_size : {4, 8, 16, 32, 8}) {
+            MultiFab mfc = make_mf(max_grid_size);
+            FabArrayBase::comm_metadata_dir.clear();
+            Metadata fresh_c = build(mfc, mfa_src, ng, period);
+            FabArrayBase::comm_metadata_dir = dir_c;
+            Metadata written_c = build(mfc, mfa_src, ng, period);
+            check(fresh_c, written_c);
+            Metadata read_c = build(mfc, mfa_src, ng, period);
+            check(fresh_c, read_c);
+            ParallelDescriptor::Barrier();
+            if (ParallelDescriptor::IOProcessor()) {
+                for (int rank = 0; rank < ParallelDescriptor::NProcs(); ++rank) {
+                    auto nfiles = fb_files(dir_c, rank).size();
+                    AMREX_ALWAYS_ASSERT(nfiles >= 1 && nfiles <= 2);
+                }
+            }
+        }
+
+        amrex::Print() << "Communication metadata read from files agree\n";
+    }
+    amrex::Finalize();
+}
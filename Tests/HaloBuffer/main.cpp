@@ -0,0 +1,118 @@
+#include <AMReX.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_HaloBuffer.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Reduce.H>
+
+using namespace amrex;
+
+namespace {
+    Long test_halo (Geometry const& geom, BoxArray const& ba, IntVect const& ng)
+    {
+        DistributionMapping dm(ba);
+
+        // Component 1 is the one we put in the halo.
+        MultiFab mf(ba,dm,2,0);
+
+        auto const& len = geom.Domain().length3d();
+        auto const& lo = lbound(geom.Domain());
+        auto expected = [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                while (i <  lo.x       ) { i += len[0]; }
+                while (i >= lo.x+len[0]) { i -= len[0]; }
+                while (j <  lo.y       ) { j += len[1]; }
+                while (j >= lo.y+len[1]) { j -= len[1]; }
+                while (k <  lo.z       ) { k += len[2]; }
+                while (k >= lo.z+len[2]) { k -= len[2]; }
+                return Real(i) + Real(j)*Real(len[0]) + Real(k)*Real(len[0])*Real(len[1]);
+            };
+
+        auto const& ma = mf.arrays();
+        ParallelFor(mf, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+        {
+            ma[b](i,j,k,0) = Real(-1.0);
+            ma[b](i,j,k,1) = expected(i,j,k);
+        });
+        Gpu::streamSynchronize();
+
+        HaloBuffer<MultiFab> halo(mf, ng, 1, geom.periodicity());
+        halo.FillBoundary(mf, 1);
+
+        Long npts_allocated = halo.numAllocatedPts();
+        Long npts_aliased = halo.numAliasedPts();
+        ParallelDescriptor::ReduceLongSum(npts_allocated);
+        ParallelDescriptor::ReduceLongSum(npts_aliased);
+        amrex::Print() << "  halo cells allocated: " << npts_allocated
+                       << ", aliased: " << npts_aliased
+                       << ", ghost cells of a grown MultiFab: "
+                       << BoxArray(ba).grow(ng).numPts() - ba.numPts() << "\n";
+
+        // Cells outside a non-periodic boundary are not filled.
+        Box const& pdomain = amrex::convert(geom.growPeriodicDomain(ng), ba.ixType());
+
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Long> reduce_data(reduce_op);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            Box const& bx = amrex::grow(mfi.validbox(),ng) & pdomain;
+            auto const& a = halo.const_array(mfi, mf, 1);
+            reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> GpuTuple<Long>
+            {
+                return { Long(!a.contains(i,j,k) || a(i,j,k) != expected(i,j,k)) };
+            });
+        }
+        Long nerrors = amrex::get<0>(reduce_data.value(reduce_op));
+        ParallelDescriptor::ReduceLongSum(nerrors);
+        return nerrors;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        Box box(IntVect(0), IntVect(AMREX_D_DECL(63, 63, 31)));
+        Long nerrors = 0;
+
+        {
+            amrex::Print() << "Periodic, cell-centered\n";
+            Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+            Geometry geom(box, RealBox(AMREX_D_DECL(Real(0),Real(0),Real(0)),
+                                       AMREX_D_DECL(Real(1),Real(1),Real(1))),
+                          CoordSys::cartesian, is_periodic);
+            BoxArray ba(box);
+            ba.maxSize(16);
+            nerrors += test_halo(geom, ba, IntVect(4));
+        }
+
+        {
+            amrex::Print() << "Partially periodic, cell-centered, irregular boxes\n";
+            Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,0,1)};
+            Geometry geom(box, RealBox(AMREX_D_DECL(Real(0),Real(0),Real(0)),
+                                       AMREX_D_DECL(Real(1),Real(1),Real(1))),
+                          CoordSys::cartesian, is_periodic);
+            BoxArray ba(box);
+            ba.maxSize(IntVect(AMREX_D_DECL(16,8,32)));
+            nerrors += test_halo(geom, ba, IntVect(AMREX_D_DECL(2,3,1)));
+        }
+
+        {
+            amrex::Print() << "Periodic, nodal in the first direction\n";
+            Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+            Geometry geom(box, RealBox(AMREX_D_DECL(Real(0),Real(0),Real(0)),
+                                       AMREX_D_DECL(Real(1),Real(1),Real(1))),
+                          CoordSys::cartesian, is_periodic);
+            BoxArray ba(box);
+            ba.maxSize(16);
+            ba.convert(IntVect(AMREX_D_DECL(1,0,0)));
+            nerrors += test_halo(geom, ba, IntVect(2));
+        }
+
+        AMREX_ALWAYS_ASSERT(nerrors == 0);
+
+        if (nerrors == 0) {
+            amrex::Print() << "SUCCESS\n";
+        }
+    }
+    amrex::Finalize();
+}
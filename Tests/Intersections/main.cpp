@@ -0,0 +1,90 @@
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+
+using namespace amrex;
+
+// Compare the batched BoxArray::intersections with the single Box version.
+
+namespace {
+
+Box random_box (Box const& domain, int max_size)
+{
+    IntVect lo, hi;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        // Some boxes stick out of the domain or are entirely outside.
+        int len = domain.length(idim);
+        lo[idim] = domain.smallEnd(idim) - len/4
+            + static_cast<int>(Random_int(static_cast<unsigned int>(len + len/2)));
+        hi[idim] = lo[idim] + static_cast<int>(Random_int(static_cast<unsigned int>(max_size)));
+    }
+    return Box(lo, hi);
+}
+
+// Returns the number of queries without intersections.
+int check (BoxArray const& ba, Vector<Box> const& bxs, IntVect const& ng)
+{
+    Vector<std::pair<int,Box>> isects;
+    Vector<int> offsets;
+    ba.intersections(bxs, isects, offsets, ng);
+
+    const int N = static_cast<int>(bxs.size());
+    AMREX_ALWAYS_ASSERT(static_cast<int>(offsets.size()) == N+1);
+    AMREX_ALWAYS_ASSERT(offsets[0] == 0 && offsets[N] == static_cast<int>(isects.size()));
+
+    int nempty = 0;
+    std::vector<std::pair<int,Box>> expected;
+    for (int i = 0; i < N; ++i) {
+        ba.intersections(bxs[i], expected, false, ng);
+        AMREX_ALWAYS_ASSERT(offsets[i+1]-offsets[i] == static_cast<int>(expected.size()));
+        for (int j = 0, M = static_cast<int>(expected.size()); j < M; ++j) {
+            AMREX_ALWAYS_ASSERT(isects[offsets[i]+j] == expected[j]);
+        }
+        if (expected.empty()) { ++nempty; }
+    }
+    return nempty;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        Box domain(IntVect(0), IntVect(127));
+
+        // Regular grids with some holes, and cell-centered and nodal versions.
+        BoxList bl(domain);
+        bl.maxSize(16);
+        BoxList bl_holes;
+        int ibox = 0;
+        for (auto const& b : bl) {
+            if (ibox++ % 5 != 0) { bl_holes.push_back(b); }
+        }
+        BoxArray ba(std::move(bl_holes));
+        BoxArray ba_nodal = amrex::convert(ba, IntVect(1));
+
+        for (int nqueries : {0, 10, 1000}) {
+            Vector<Box> bxs;
+            for (int i = 0; i < nqueries; ++i) {
+                bxs.push_back(random_box(domain, 40));
+            }
+            Vector<Box> bxs_nodal;
+            for (auto const& b : bxs) {
+                bxs_nodal.push_back(amrex::surroundingNodes(b));
+            }
+
+            for (IntVect const& ng : {IntVect(0), IntVect(1), IntVect(AMREX_D_DECL(2,0,1))}) {
+                int nempty = check(ba, bxs, ng);
+                check(ba_nodal, bxs_nodal, ng);
+                amrex::Print() << nqueries << " queries with ng = " << ng
+                               << ": " << nempty << " without intersections\n";
+                if (nqueries == 1000) {
+                    AMREX_ALWAYS_ASSERT(nempty > 0 && nempty < nqueries);
+                }
+            }
+        }
+    }
+    amrex::Finalize();
+}
@@ -84,6 +84,8 @@ MyTest::solvePoisson ()
         MLMG mlmg(mlpoisson);
         mlmg.setMaxIter(max_iter);
         mlmg.setMaxFmgIter(max_fmg_iter);
+        mlmg.setCycle(static_cast<MLMG::MGCycle>(mg_cycle));
+        mlmg.setAdaptiveCycle(adaptive_cycle);
         mlmg.setVerbose(verbose);
         mlmg.setBottomVerbose(bottom_verbose);
 #ifdef AMREX_USE_HYPRE
@@ -127,6 +129,8 @@ MyTest::solvePoisson ()
             MLMG mlmg(mlpoisson);
             mlmg.setMaxIter(max_iter);
             mlmg.setMaxFmgIter(max_fmg_iter);
+            mlmg.setCycle(static_cast<MLMG::MGCycle>(mg_cycle));
+            mlmg.setAdaptiveCycle(adaptive_cycle);
             mlmg.setVerbose(verbose);
             mlmg.setBottomVerbose(bottom_verbose);
 #ifdef AMREX_USE_HYPRE
@@ -203,6 +207,8 @@ MyTest::solveABecLaplacian ()
         MLMG mlmg(mlabec);
         mlmg.setMaxIter(max_iter);
         mlmg.setMaxFmgIter(max_fmg_iter);
+        mlmg.setCycle(static_cast<MLMG::MGCycle>(mg_cycle));
+        mlmg.setAdaptiveCycle(adaptive_cycle);
         mlmg.setVerbose(verbose);
         mlmg.setBottomVerbose(bottom_verbose);
 #ifdef AMREX_USE_HYPRE
@@ -260,6 +266,8 @@ MyTest::solveABecLaplacian ()
             MLMG mlmg(mlabec);
             mlmg.setMaxIter(max_iter);
             mlmg.setMaxFmgIter(max_fmg_iter);
+            mlmg.setCycle(static_cast<MLMG::MGCycle>(mg_cycle));
+            mlmg.setAdaptiveCycle(adaptive_cycle);
             mlmg.setVerbose(verbose);
             mlmg.setBottomVerbose(bottom_verbose);
 #ifdef AMREX_USE_HYPRE
@@ -336,6 +344,8 @@ MyTest::solveABecLaplacianInhomNeumann ()
         MLMG mlmg(mlabec);
         mlmg.setMaxIter(max_iter);
         mlmg.setMaxFmgIter(max_fmg_iter);
+        mlmg.setCycle(static_cast<MLMG::MGCycle>(mg_cycle));
+        mlmg.setAdaptiveCycle(adaptive_cycle);
         mlmg.setVerbose(verbose);
         mlmg.setBottomVerbose(bottom_verbose);
 #ifdef AMREX_USE_HYPRE
@@ -395,6 +405,8 @@ MyTest::solveABecLaplacianInhomNeumann ()
             MLMG mlmg(mlabec);
             mlmg.setMaxIter(max_iter);
             mlmg.setMaxFmgIter(max_fmg_iter);
+            mlmg.setCycle(static_cast<MLMG::MGCycle>(mg_cycle));
+            mlmg.setAdaptiveCycle(adaptive_cycle);
             mlmg.setVerbose(verbose);
             mlmg.setBottomVerbose(bottom_verbose);
 #ifdef AMREX_USE_HYPRE
@@ -454,6 +466,8 @@ MyTest::solveNodeABecLaplacian ()
             MLMG mlmg(mlndabec);
             mlmg.setMaxIter(max_iter);
             mlmg.setMaxFmgIter(max_fmg_iter);
+            mlmg.setCycle(static_cast<MLMG::MGCycle>(mg_cycle));
+            mlmg.setAdaptiveCycle(adaptive_cycle);
             mlmg.setVerbose(verbose);
             mlmg.setBottomVerbose(bottom_verbose);
 
@@ -519,7 +533,13 @@ MyTest::solveABecLaplacianGMRES ()
         GMRESMLMG gmsolver(mlmg);
         gmsolver.usePrecond(true);
         gmsolver.setVerbose(verbose);
-        gmsolver.solve(solution[ilev], rhs[ilev], tol_rel, tol_abs);
+        gmsolver.setRecycleSize(gmres_recycle_size);
+        for (int isolve = 0; isolve < gmres_nsolves; ++isolve) {
+            if (isolve > 0) {
+                rhs[ilev].mult(Real(1.1));
+            }
+            gmsolver.solve(solution[ilev], rhs[ilev], tol_rel, tol_abs);
+        }
 
         if (verbose) {
             MultiFab res(rhs[ilev].boxArray(), rhs[ilev].DistributionMap(), 1, 0);
@@ -551,6 +571,8 @@ MyTest::readParameters ()
     pp.query("bottom_verbose", bottom_verbose);
     pp.query("max_iter", max_iter);
     pp.query("max_fmg_iter", max_fmg_iter);
+    pp.query("mg_cycle", mg_cycle);
+    pp.query("adaptive_cycle", adaptive_cycle);
     pp.query("linop_maxorder", linop_maxorder);
     pp.query("agglomeration", agglomeration);
     pp.query("consolidation", consolidation);
@@ -561,6 +583,8 @@ MyTest::readParameters ()
     pp.query("use_gauss_seidel", use_gauss_seidel);
 
     pp.query("use_gmres", use_gmres);
+    pp.query("gmres_recycle_size", gmres_recycle_size);
+    pp.query("gmres_nsolves", gmres_nsolves);
     AMREX_ALWAYS_ASSERT(use_gmres == false || prob_type == 2);
 
 #ifdef AMREX_USE_HYPRE
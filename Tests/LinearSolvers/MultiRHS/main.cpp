@@ -0,0 +1,120 @@
+#include <AMReX.H>
+#include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+// Solve (alpha a - beta div b grad) phi = rhs for several right-hand sides
+// at once with MLMG::solveMultiRHS, and compare with solving them one by one.
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 32;
+        int nrhs = 3;
+        Real reltol = 1.e-10;
+        int verbose = 1;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nrhs", nrhs);
+            pp.query("reltol", reltol);
+            pp.query("verbose", verbose);
+        }
+
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)),
+                      RealBox(AMREX_D_DECL(0.,0.,0.), AMREX_D_DECL(1.,1.,1.)),
+                      CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+        BoxArray ba(geom.Domain());
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        auto const dx = geom.CellSizeArray();
+        auto const problo = geom.ProbLoArray();
+
+        // Component n has frequency n+1 and amplitude 10^n so that the
+        // components need different numbers of iterations.  The last
+        // component has a zero rhs and needs no iterations at all.
+        MultiFab rhs(ba, dm, nrhs, 0);
+        auto const& rhs_ma = rhs.arrays();
+        ParallelFor(rhs, IntVect(0), nrhs,
+        [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n) noexcept
+        {
+            if (n == nrhs-1 && nrhs > 1) {
+                rhs_ma[b](i,j,k,n) = Real(0.0);
+            } else {
+                Real f = Real(2.0*3.141592653589793*(n+1));
+                Real amp = std::pow(Real(10.0), Real(n));
+                AMREX_D_TERM(Real x = problo[0] + (i+Real(0.5))*dx[0];,
+                             Real y = problo[1] + (j+Real(0.5))*dx[1];,
+                             Real z = problo[2] + (k+Real(0.5))*dx[2];)
+                rhs_ma[b](i,j,k,n) = amp * AMREX_D_TERM(std::sin(f*x),
+                                                       *std::sin(f*y),
+                                                       *std::sin(f*z));
+            }
+        });
+
+        MultiFab acoef(ba, dm, 1, 0);
+        acoef.setVal(1.0);
+        Array<MultiFab,AMREX_SPACEDIM> bcoef;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bcoef[idim].define(amrex::convert(ba,IntVect::TheDimensionVector(idim)), dm, 1, 0);
+            bcoef[idim].setVal(1.0);
+        }
+
+        auto setup = [&] (MLABecLaplacian& linop)
+        {
+            linop.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet)},
+                              {AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet)});
+            linop.setLevelBC(0, nullptr);
+            linop.setScalars(1.0, 1.0);
+            linop.setACoeffs(0, acoef);
+            linop.setBCoeffs(0, GetArrOfConstPtrs(bcoef));
+        };
+
+        MultiFab sol_block(ba, dm, nrhs, 1);
+        sol_block.setVal(0.0);
+        {
+            MLABecLaplacian linop({geom}, {ba}, {dm}, LPInfo(), {}, nrhs);
+            setup(linop);
+            MLMG mlmg(linop);
+            mlmg.setVerbose(verbose);
+            mlmg.solveMultiRHS(Vector<MultiFab*>{&sol_block}, Vector<MultiFab const*>{&rhs},
+                               reltol, Real(0.0));
+            auto const& niters = mlmg.getNumItersComps();
+            for (int n = 0; n < nrhs; ++n) {
+                amrex::Print() << "  Component " << n << ": " << niters[n] << " iterations\n";
+            }
+        }
+
+        MultiFab sol_single(ba, dm, 1, 1);
+        Real max_diff = 0.0;
+        for (int n = 0; n < nrhs; ++n) {
+            MultiFab rhs_n(rhs, amrex::make_alias, n, 1);
+            sol_single.setVal(0.0);
+            MLABecLaplacian linop({geom}, {ba}, {dm});
+            setup(linop);
+            MLMG mlmg(linop);
+            mlmg.setVerbose(0);
+            mlmg.solve({&sol_single}, {&rhs_n}, reltol, Real(0.0));
+
+            MultiFab::Subtract(sol_single, sol_block, n, 0, 1, 0);
+            Real diff = sol_single.norminf(0) / std::max(sol_block.norminf(n), Real(1.e-30));
+            amrex::Print() << "  Component " << n << ": relative difference to single solve = "
+                           << diff << "\n";
+            max_diff = std::max(max_diff, diff);
+        }
+
+        AMREX_ALWAYS_ASSERT(max_diff < Real(1.e-6));
+    }
+    amrex::Finalize();
+}
@@ -29,6 +29,10 @@ MyTest::solve ()
     {
         MLNodeLaplacian linop(geom, grids, dmap, info);
         //linop.setSmoothNumSweeps(smooth_num_sweeps);
+        if (use_rap) {
+            linop.setCoarseningStrategy(MLNodeLaplacian::CoarseningStrategy::RAP);
+        }
+        linop.setReducedPrecisionStencil(reduced_precision_stencil);
 
         linop.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
                                         LinOpBCType::Dirichlet,
@@ -60,12 +64,20 @@ MyTest::solve ()
         }
 
         mlmg.solve(GetVecOfPtrs(solution), GetVecOfConstPtrs(rhs), reltol, 0.0);
+        // with the stencils of the coarse MG levels in reduced precision, the
+        // solve must still reach the requested tolerance
+        AMREX_ALWAYS_ASSERT(mlmg.getFinalResidual() <=
+                            reltol*std::max(mlmg.getInitRHS(), mlmg.getInitResidual()));
     }
     else // solve level by level
     {
         for (int ilev = 0; ilev <= max_level; ++ilev)
         {
             MLNodeLaplacian linop({geom[ilev]}, {grids[ilev]}, {dmap[ilev]}, info);
+            if (use_rap) {
+                linop.setCoarseningStrategy(MLNodeLaplacian::CoarseningStrategy::RAP);
+            }
+            linop.setReducedPrecisionStencil(reduced_precision_stencil);
 
             linop.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
                                             LinOpBCType::Dirichlet,
@@ -119,6 +131,8 @@ MyTest::solve ()
                 gmsolver.solve(solution[ilev], rhs[ilev], reltol, 0.0);
             } else {
                 mlmg.solve({&solution[ilev]}, {&rhs[ilev]}, reltol, 0.0);
+                AMREX_ALWAYS_ASSERT(mlmg.getFinalResidual() <=
+                                    reltol*std::max(mlmg.getInitRHS(), mlmg.getInitResidual()));
             }
         }
     }
@@ -172,6 +186,8 @@ MyTest::readParameters ()
     pp.query("max_coarsening_level", max_coarsening_level);
     pp.query("max_semicoarsening_level", max_semicoarsening_level);
     //pp.query("smooth_num_sweeps", smooth_num_sweeps);
+    pp.query("use_rap", use_rap);
+    pp.query("reduced_precision_stencil", reduced_precision_stencil);
 
     pp.query("do_plots", do_plots);
     pp.query("num_trials", num_trials);
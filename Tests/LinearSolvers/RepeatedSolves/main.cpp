@@ -0,0 +1,281 @@
+#include <AMReX.H>
+#include <AMReX_GMRES_MLMG.H>
+#include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+// Solve (alpha a - beta div b grad) phi = rhs repeatedly, reusing solver
+// objects and state between the solves, and compare with fresh solves.
+
+namespace {
+
+struct TestParams
+{
+    int n_cell = 64;
+    int max_grid_size = 16;
+    Real reltol = 1.e-10;
+    int verbose = 1;
+};
+
+struct Problem
+{
+    Geometry geom;
+    BoxArray ba;
+    DistributionMapping dm;
+    MultiFab rhs;
+    MultiFab acoef;
+    Array<MultiFab,AMREX_SPACEDIM> bcoef;
+
+    Problem (TestParams const& params, int max_grid_size)
+    {
+        const int n_cell = params.n_cell;
+        geom.define(Box(IntVect(0), IntVect(n_cell-1)),
+                    RealBox(AMREX_D_DECL(0.,0.,0.), AMREX_D_DECL(1.,1.,1.)),
+                    CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+        ba.define(geom.Domain());
+        ba.maxSize(max_grid_size);
+        dm.define(ba);
+
+        auto const dx = geom.CellSizeArray();
+        auto const problo = geom.ProbLoArray();
+
+        rhs.define(ba, dm, 1, 0);
+        auto const& rhs_ma = rhs.arrays();
+        ParallelFor(rhs, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k) noexcept
+        {
+            constexpr Real f = Real(2.0*3.141592653589793);
+            AMREX_D_TERM(Real x = problo[0] + (i+Real(0.5))*dx[0];,
+                         Real y = problo[1] + (j+Real(0.5))*dx[1];,
+                         Real z = problo[2] + (k+Real(0.5))*dx[2];)
+            rhs_ma[b](i,j,k) = AMREX_D_TERM(std::sin(f*x), *std::sin(f*y), *std::sin(f*z));
+        });
+
+        acoef.define(ba, dm, 1, 0);
+        acoef.setVal(1.0);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bcoef[idim].define(amrex::convert(ba,IntVect::TheDimensionVector(idim)), dm, 1, 0);
+            bcoef[idim].setVal(1.0);
+        }
+    }
+
+    void setup (MLABecLaplacian& linop) const
+    {
+        linop.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet)},
+                          {AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet,
+                                        LinOpBCType::Dirichlet)});
+        linop.setLevelBC(0, nullptr);
+        linop.setScalars(1.0, 1.0);
+        linop.setACoeffs(0, acoef);
+        linop.setBCoeffs(0, GetArrOfConstPtrs(bcoef));
+    }
+
+    void solve (MultiFab& sol, LPInfo const& info, TestParams const& params) const
+    {
+        MLABecLaplacian linop({geom}, {ba}, {dm}, info);
+        setup(linop);
+        MLMG mlmg(linop);
+        mlmg.setVerbose(params.verbose);
+        sol.setVal(0.0);
+        mlmg.solve({&sol}, {&rhs}, params.reltol, Real(0.0));
+    }
+};
+
+Real relDiff (MultiFab const& a, MultiFab const& b)
+{
+    MultiFab diff(a.boxArray(), a.DistributionMap(), 1, 0);
+    MultiFab::LinComb(diff, Real(1.0), a, 0, Real(-1.0), b, 0, 0, 1, 0);
+    return diff.norminf() / std::max(b.norminf(), Real(1.e-30));
+}
+
+// Operators that share an MLLinOpSetupCache reuse the multigrid hierarchy
+// and give the same solution as operators that build their own.
+void testSetupCache (TestParams const& params)
+{
+    amrex::Print() << "testSetupCache\n";
+
+    Problem prob(params, params.max_grid_size);
+
+    MultiFab sol_ref(prob.ba, prob.dm, 1, 1);
+    prob.solve(sol_ref, LPInfo(), params);
+
+    auto cache = std::make_shared<MLLinOpSetupCache>();
+    LPInfo info;
+    info.setSetupCache(cache);
+
+    MultiFab sol(prob.ba, prob.dm, 1, 1);
+    for (int isolve = 0; isolve < 2; ++isolve) {
+        prob.solve(sol, info, params);
+        AMREX_ALWAYS_ASSERT(cache->numHits() == isolve);
+        const Real diff = relDiff(sol, sol_ref);
+        amrex::Print() << "  Solve " << isolve << ": relative difference to uncached solve = "
+                       << diff << "\n";
+        AMREX_ALWAYS_ASSERT(diff < Real(1.e-12));
+    }
+
+    // A different BoxArray must not reuse the cached hierarchy.
+    Problem prob2(params, params.max_grid_size/2);
+    MultiFab sol2_ref(prob2.ba, prob2.dm, 1, 1);
+    prob2.solve(sol2_ref, LPInfo(), params);
+
+    MultiFab sol2(prob2.ba, prob2.dm, 1, 1);
+    prob2.solve(sol2, info, params);
+    AMREX_ALWAYS_ASSERT(cache->numHits() == 1);
+    AMREX_ALWAYS_ASSERT(relDiff(sol2, sol2_ref) < Real(1.e-12));
+
+    // The new hierarchy replaces the old one in the cache.
+    prob2.solve(sol2, info, params);
+    AMREX_ALWAYS_ASSERT(cache->numHits() == 2);
+    prob.solve(sol, info, params);
+    AMREX_ALWAYS_ASSERT(cache->numHits() == 2);
+}
+
+
+// Repeated solves with the adaptive cycle schedule on one MLMG.  The
+// schedule carries over from solve to solve, but the user's cycle and
+// smoothing sweeps must not change.
+void testAdaptiveCycle (TestParams const& params)
+{
+    amrex::Print() << "testAdaptiveCycle\n";
+
+    Problem prob(params, params.max_grid_size);
+    MultiFab rhs(prob.ba, prob.dm, 1, 0);
+    MultiFab sol(prob.ba, prob.dm, 1, 1);
+    MultiFab sol_ref(prob.ba, prob.dm, 1, 1);
+
+    MLABecLaplacian linop({prob.geom}, {prob.ba}, {prob.dm});
+    prob.setup(linop);
+    MLMG mlmg(linop);
+    mlmg.setVerbose(params.verbose);
+    mlmg.setPreSmooth(6);
+    mlmg.setPostSmooth(6);
+    mlmg.setAdaptiveCycle(true);
+
+    MLABecLaplacian linop_ref({prob.geom}, {prob.ba}, {prob.dm});
+    prob.setup(linop_ref);
+    MLMG mlmg_ref(linop_ref);
+    mlmg_ref.setVerbose(0);
+    mlmg_ref.setPreSmooth(6);
+    mlmg_ref.setPostSmooth(6);
+
+    // More solves than the interval after which a cycle is revisited, with
+    // both warm and cold starts.
+    const int nsolves = 24;
+    sol.setVal(0.0);
+    for (int isolve = 0; isolve < nsolves; ++isolve) {
+        MultiFab::Copy(rhs, prob.rhs, 0, 0, 1, 0);
+        rhs.mult(Real(1.0) + Real(0.1)*Real(isolve%5));
+        if (isolve % 8 == 0) { sol.setVal(0.0); }
+        mlmg.solve({&sol}, {&rhs}, params.reltol, Real(0.0));
+
+        AMREX_ALWAYS_ASSERT(mlmg.getCycle() == MLMG::MGCycle::V);
+        AMREX_ALWAYS_ASSERT(mlmg.getPreSmooth() == 6 && mlmg.getPostSmooth() == 6);
+
+        sol_ref.setVal(0.0);
+        mlmg_ref.solve({&sol_ref}, {&rhs}, params.reltol, Real(0.0));
+        AMREX_ALWAYS_ASSERT(relDiff(sol, sol_ref) < Real(1.e-8));
+    }
+
+    // Without the adaptive schedule, the solver behaves like a new one
+    // with the user's settings.
+    mlmg.setAdaptiveCycle(false);
+    sol.setVal(0.0);
+    sol_ref.setVal(0.0);
+    mlmg.solve({&sol}, {&prob.rhs}, params.reltol, Real(0.0));
+    mlmg_ref.solve({&sol_ref}, {&prob.rhs}, params.reltol, Real(0.0));
+    amrex::Print() << "  Iterations after the adaptive solves: " << mlmg.getNumIters()
+                   << ", new solver: " << mlmg_ref.getNumIters() << "\n";
+    AMREX_ALWAYS_ASSERT(mlmg.getNumIters() == mlmg_ref.getNumIters());
+}
+
+
+// GMRES with recycled search directions needs fewer iterations for a
+// second, similar right-hand side.
+void testGMRESRecycle (TestParams const& params)
+{
+    amrex::Print() << "testGMRESRecycle\n";
+
+    // Unpreconditioned GMRES on a small problem, so that the iteration
+    // counts are meaningful but cheap.
+    TestParams small_params = params;
+    small_params.n_cell = 16;
+    Problem prob(small_params, 8);
+    MultiFab rhs(prob.ba, prob.dm, 1, 0);
+    MultiFab sol(prob.ba, prob.dm, 1, 1);
+
+    // The second rhs is the first one scaled, plus a small perturbation.
+    MultiFab rhs2(prob.ba, prob.dm, 1, 0);
+    {
+        auto const dx = prob.geom.CellSizeArray();
+        auto const problo = prob.geom.ProbLoArray();
+        auto const& rhs_ma = prob.rhs.const_arrays();
+        auto const& rhs2_ma = rhs2.arrays();
+        ParallelFor(rhs2, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k) noexcept
+        {
+            constexpr Real f = Real(6.0*3.141592653589793);
+            AMREX_D_TERM(Real x = problo[0] + (i+Real(0.5))*dx[0];,
+                         Real y = problo[1] + (j+Real(0.5))*dx[1];,
+                         Real z = problo[2] + (k+Real(0.5))*dx[2];)
+            rhs2_ma[b](i,j,k) = Real(1.1)*rhs_ma[b](i,j,k)
+                + Real(0.01)*AMREX_D_TERM(std::sin(f*x), *std::sin(f*y), *std::sin(f*z));
+        });
+    }
+
+    auto gmres_iters = [&] (int recycle_size)
+    {
+        MLABecLaplacian linop({prob.geom}, {prob.ba}, {prob.dm});
+        prob.setup(linop);
+        MLMG mlmg(linop);
+        GMRESMLMG gmsolver(mlmg);
+        gmsolver.usePrecond(false);
+        gmsolver.setVerbose(params.verbose);
+        gmsolver.setMaxIters(500);
+        gmsolver.setRecycleSize(recycle_size);
+
+        Vector<int> niters;
+        for (auto const* b : {&prob.rhs, &rhs2}) {
+            MultiFab::Copy(rhs, *b, 0, 0, 1, 0);
+            sol.setVal(0.0);
+            gmsolver.solve(sol, rhs, Real(1.e-6), Real(0.0));
+            niters.push_back(gmsolver.getNumIters());
+        }
+        AMREX_ALWAYS_ASSERT(recycle_size == 0 || gmsolver.getGMRES().getNumRecycled() > 0);
+        return niters;
+    };
+
+    auto niters = gmres_iters(0);
+    auto niters_rc = gmres_iters(10);
+    amrex::Print() << "  GMRES iterations without recycling: " << niters[0] << ", " << niters[1]
+                   << "; with recycling: " << niters_rc[0] << ", " << niters_rc[1] << "\n";
+
+    AMREX_ALWAYS_ASSERT(niters_rc[0] == niters[0]);
+    AMREX_ALWAYS_ASSERT(niters_rc[1] < niters_rc[0]);
+    AMREX_ALWAYS_ASSERT(niters_rc[1] < niters[1]);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        TestParams params;
+        {
+            ParmParse pp;
+            pp.query("n_cell", params.n_cell);
+            pp.query("max_grid_size", params.max_grid_size);
+            pp.query("reltol", params.reltol);
+            pp.query("verbose", params.verbose);
+        }
+
+        testSetupCache(params);
+        testAdaptiveCycle(params);
+        testGMRESRecycle(params);
+    }
+    amrex::Finalize();
+}
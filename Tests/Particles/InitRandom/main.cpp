@@ -12,12 +12,14 @@ void set_grids_nested (Vector<Box>& domains,
                        Vector<IntVect>& ref_ratio);
 void test ();
 void testSOA ();
+void testDeterministic ();
 
 int main(int argc, char* argv[])
 {
     amrex::Initialize(argc,argv);
     test();
     testSOA();
+    testDeterministic();
     amrex::Finalize();
 }
 
@@ -138,6 +140,112 @@ void test ()
     amrex::Print() << "Generated " << myPC.TotalNumberOfParticles() << " particles. \n";
 }
 
+// An order-independent checksum of the positions, the real struct data and,
+// optionally, the ids of all the particles.
+template <class PC>
+ULong checksum (PC const& pc, bool with_id)
+{
+    using PType = typename PC::SuperParticleType;
+    ULong r = amrex::ReduceSum(pc,
+        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> ULong
+        {
+            ULong h = with_id ? static_cast<ULong>(p.id()) : 0;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                h = h*0x100000001b3ULL + static_cast<ULong>(double(p.pos(d))*0x1.0p40);
+            }
+            for (int i = 0; i < PC::NStructReal; ++i) {
+                h = h*0x100000001b3ULL + static_cast<ULong>(double(p.rdata(i))*0x1.0p40);
+            }
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return h;
+        });
+    ParallelAllReduce::Sum(r, ParallelDescriptor::Communicator());
+    return r;
+}
+
+void testDeterministic ()
+{
+    int ncells, max_grid_size, nppc;
+
+    ParmParse pp;
+    pp.get("ncells", ncells);
+    pp.get("max_grid_size", max_grid_size);
+    pp.get("nppc", nppc);
+
+    ncells /= 2;
+
+    const Box domain(IntVect(AMREX_D_DECL(0, 0, 0)),
+                     IntVect(AMREX_D_DECL(ncells-1, ncells-1, ncells-1)));
+
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++) {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, 1.0);
+    }
+    int is_per[] = {AMREX_D_DECL(1,1,1)};
+    const Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+    // Two different decompositions of the same domain
+    BoxArray ba1(domain);
+    ba1.maxSize(max_grid_size);
+    DistributionMapping dm1(ba1);
+
+    BoxArray ba2(domain);
+    ba2.maxSize(max_grid_size/2);
+    Vector<int> pmap(ba2.size());
+    for (int i = 0; i < ba2.size(); ++i) {
+        pmap[i] = (ba2.size()-1-i) % ParallelDescriptor::NProcs();
+    }
+    DistributionMapping dm2(pmap);
+
+    using MyPC = ParticleContainer<2, 1>;
+    MyPC::ParticleInitData pdata = {{1.0, 2.0}, {3}, {}, {}};
+
+    MyPC pc1(geom, dm1, ba1);
+    pc1.InitNRandomPerCell(nppc, pdata, 451);
+
+    MyPC pc2(geom, dm2, ba2);
+    pc2.InitNRandomPerCell(nppc, pdata, 451);
+
+    MyPC pc3(geom, dm1, ba1);
+    pc3.InitNRandomPerCell(nppc, pdata, 452);
+
+    const Long np = nppc * domain.numPts();
+    AMREX_ALWAYS_ASSERT(pc1.TotalNumberOfParticles() == np);
+    AMREX_ALWAYS_ASSERT(pc2.TotalNumberOfParticles() == np);
+    AMREX_ALWAYS_ASSERT(pc1.OK() && pc2.OK());
+
+    const ULong sum1 = checksum(pc1, true);
+    AMREX_ALWAYS_ASSERT(checksum(pc2, true) == sum1);
+    AMREX_ALWAYS_ASSERT(checksum(pc3, true) != sum1);
+    amrex::Print() << "Generated " << np << " particles deterministically, checksum " << sum1 << " \n";
+
+    // Write the particles with a spatial index and read them back on both
+    // decompositions, each process reading only the bins it needs.
+    pc2.WriteIndexedBinaryFile("particles.bin", 2, IntVect(8));
+
+    MyPC pc4(geom, dm1, ba1);
+    pc4.InitFromIndexedBinaryFile("particles.bin", 2);
+
+    MyPC pc5(geom, dm2, ba2);
+    pc5.InitFromIndexedBinaryFile("particles.bin", 2);
+
+    AMREX_ALWAYS_ASSERT(pc4.TotalNumberOfParticles() == np);
+    AMREX_ALWAYS_ASSERT(pc5.TotalNumberOfParticles() == np);
+    AMREX_ALWAYS_ASSERT(pc4.OK() && pc5.OK());
+    AMREX_ALWAYS_ASSERT(checksum(pc4, false) == checksum(pc1, false));
+    AMREX_ALWAYS_ASSERT(checksum(pc4, true) == checksum(pc5, true));
+
+    // The file is still readable by InitFromBinaryFile.
+    MyPC pc6(geom, dm1, ba1);
+    pc6.InitFromBinaryFile("particles.bin", 2);
+    AMREX_ALWAYS_ASSERT(pc6.TotalNumberOfParticles() == np);
+    AMREX_ALWAYS_ASSERT(checksum(pc6, false) == checksum(pc1, false));
+    amrex::Print() << "Read back " << np << " particles from an indexed binary file. \n";
+}
+
 void set_grids_nested (Vector<Box>& domains,
                        Vector<BoxArray>& grids,
                        Vector<IntVect>& ref_ratio)
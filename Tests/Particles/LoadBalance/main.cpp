@@ -0,0 +1,149 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Particles.H>
+#include <AMReX_ParticleLoadBalance.H>
+
+using namespace amrex;
+
+using MyPC = ParticleContainer<1, 0>;
+
+struct TestParams
+{
+    IntVect size;
+    int max_grid_size;
+    int num_background;
+    int num_cluster;
+    Real cell_weight;
+    Real particle_weight;
+};
+
+void get_test_params (TestParams& params)
+{
+    ParmParse pp("balance");
+    pp.get("size", params.size);
+    pp.get("max_grid_size", params.max_grid_size);
+    pp.get("num_background", params.num_background);
+    pp.get("num_cluster", params.num_cluster);
+    pp.get("cell_weight", params.cell_weight);
+    pp.get("particle_weight", params.particle_weight);
+}
+
+// Fill each cell with a value that depends only on its index so the mesh data
+// can be checked after it has been moved to another rank.
+void fillMesh (MultiFab& mf)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        ParallelFor(mfi.fabbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            a(i,j,k) = Real(i + 1000*j + 1000000*k);
+        });
+    }
+}
+
+Long checkMesh (MultiFab const& mf)
+{
+    ReduceOps<ReduceOpSum> reduce_op;
+    ReduceData<Long> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.const_array(mfi);
+        reduce_op.eval(mfi.fabbox(), reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            return {a(i,j,k) != Real(i + 1000*j + 1000000*k)};
+        });
+    }
+    Long nbad = amrex::get<0>(reduce_data.value());
+    ParallelDescriptor::ReduceLongSum(nbad);
+    return nbad;
+}
+
+void testLoadBalance ()
+{
+    BL_PROFILE("testLoadBalance");
+    TestParams params;
+    get_test_params(params);
+
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++) {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, 1.0);
+    }
+
+    const Box domain(IntVect(AMREX_D_DECL(0, 0, 0)), params.size - 1);
+    Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+    const Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    // A uniform background plus a dense cluster in one corner of the domain.
+    MyPC pc(geom, dm, ba);
+    MyPC::ParticleInitData pdata = {{1.0},{},{},{}};
+    pc.InitRandom(params.num_background, 451, pdata, false);
+
+    RealBox cluster_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++) {
+        cluster_box.setLo(n, 0.0625);
+        cluster_box.setHi(n, 0.4375);
+    }
+    MyPC cluster(geom, dm, ba);
+    cluster.InitRandom(params.num_cluster, 811, pdata, false, cluster_box);
+    pc.addParticles(cluster);
+    pc.Redistribute();
+
+    const Long np_old = pc.TotalNumberOfParticles();
+
+    MultiFab mesh(ba, dm, 2, 1);
+    fillMesh(mesh);
+
+    Real eff_old = 0.0, eff_new = 0.0;
+    const DistributionMapping new_dm =
+        makeParticleBalancedDM(pc, 0, params.cell_weight, params.particle_weight,
+                               DistributionMapping::SFC, &eff_old, &eff_new);
+
+    // The same cost, measured per box on the owning rank, must give the same mapping.
+    LayoutData<Real> measured(ba, dm);
+    auto const& plev = pc.GetParticles(0);
+    for (MFIter mfi(measured); mfi.isValid(); ++mfi) {
+        auto it = plev.find(std::make_pair(mfi.index(), mfi.LocalTileIndex()));
+        const Long np = (it == plev.end()) ? 0 : it->second.numParticles();
+        measured[mfi] = params.cell_weight * static_cast<Real>(mfi.validbox().numPts())
+            + params.particle_weight * static_cast<Real>(np);
+    }
+    const DistributionMapping measured_dm = makeParticleBalancedDM(measured);
+    AMREX_ALWAYS_ASSERT(measured_dm == new_dm);
+
+    amrex::Print() << "Load balance efficiency: " << eff_old << " -> " << eff_new << "\n";
+    if (ParallelDescriptor::NProcs() > 1) {
+        AMREX_ALWAYS_ASSERT(eff_new > eff_old);
+    }
+
+    RedistributeParticlesAndMesh(pc, 0, new_dm, {&mesh});
+
+    AMREX_ALWAYS_ASSERT(pc.ParticleDistributionMap(0) == new_dm);
+    AMREX_ALWAYS_ASSERT(mesh.DistributionMap() == new_dm);
+    AMREX_ALWAYS_ASSERT(pc.TotalNumberOfParticles() == np_old);
+    AMREX_ALWAYS_ASSERT(pc.OK());
+    AMREX_ALWAYS_ASSERT(checkMesh(mesh) == 0);
+
+    // The balanced mapping is a fixed point.
+    Real eff_check = 0.0;
+    makeParticleBalancedDM(pc, 0, params.cell_weight, params.particle_weight,
+                           DistributionMapping::SFC, &eff_check);
+    AMREX_ALWAYS_ASSERT(std::abs(eff_check - eff_new) < 1.e-6_rt);
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    testLoadBalance();
+
+    amrex::Print() << "pass \n";
+
+    amrex::Finalize();
+}
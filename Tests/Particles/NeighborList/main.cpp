@@ -15,6 +15,8 @@ struct TestParams
 };
 
 void testNeighborList();
+void testVerletList();
+void testHalfNeighborList();
 
 int main (int argc, char* argv[])
 {
@@ -22,6 +24,10 @@ int main (int argc, char* argv[])
 
     testNeighborList();
 
+    testVerletList();
+
+    testHalfNeighborList();
+
     amrex::Finalize();
 }
 
@@ -139,3 +145,320 @@ void testNeighborList ()
         nlist2.print();
     }
 }
+
+namespace VerletParams
+{
+    static constexpr amrex::Real cutoff = 0.5;
+    static constexpr amrex::Real skin   = 0.3;
+    static constexpr amrex::Real vmax   = 0.02;
+}
+
+struct CheckPairWithin
+{
+    amrex::Real m_r2;
+
+    template <class P1, class P2>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    bool operator() (const P1& p1, const P2& p2) const
+    {
+        AMREX_D_TERM(amrex::Real d0 = (p1.pos(0) - p2.pos(0));,
+                     amrex::Real d1 = (p1.pos(1) - p2.pos(1));,
+                     amrex::Real d2 = (p1.pos(2) - p2.pos(2));)
+        amrex::Real dsquared = AMREX_D_TERM(d0*d0, + d1*d1, + d2*d2);
+        return (dsquared <= m_r2);
+    }
+};
+
+using VerletPC = amrex::NeighborParticleContainer<AMREX_SPACEDIM, 0>;
+
+void setVelocities (VerletPC& pc)
+{
+    for (VerletPC::MyParIter pti(pc, 0); pti.isValid(); ++pti) {
+        auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+        amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i)
+        {
+            auto& p = pstruct[i];
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                p.rdata(d) = VerletParams::vmax*std::sin(Real(7.0*(d+1))*p.pos((d+1)%AMREX_SPACEDIM));
+            }
+        });
+    }
+}
+
+void moveParticles (VerletPC& pc)
+{
+    for (VerletPC::MyParIter pti(pc, 0); pti.isValid(); ++pti) {
+        auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+        amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i)
+        {
+            auto& p = pstruct[i];
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                p.pos(d) += p.rdata(d);
+            }
+        });
+    }
+}
+
+// Number of (particle, neighbor) pairs in the list that are within the cutoff
+Long countPairs (VerletPC& pc, VerletPC::NeighborListContainerType& nlist)
+{
+    Long npairs = 0;
+    for (VerletPC::MyParIter pti(pc, 0); pti.isValid(); ++pti) {
+        const auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
+        const auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+        auto nbor_data = nlist[0][index].data();
+
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(pti.numParticles(), reduce_data,
+        [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+        {
+            CheckPairWithin within{VerletParams::cutoff*VerletParams::cutoff};
+            Long n = 0;
+            for (const auto& p2 : nbor_data.getNeighbors(i)) {
+                if (within(pstruct[i], p2)) { ++n; }
+            }
+            return {n};
+        });
+        npairs += amrex::get<0>(reduce_data.value(reduce_op));
+    }
+    ParallelDescriptor::ReduceLongSum(npairs);
+    return npairs;
+}
+
+struct VerletTestPC : public VerletPC
+{
+    using VerletPC::VerletPC;
+    NeighborListContainerType& neighborList () { return m_neighbor_list; }
+};
+
+void testVerletList ()
+{
+    BL_PROFILE("testVerletList()");
+    TestParams params;
+    get_test_params(params, "nbor_list");
+
+    RealBox real_box;
+    for (int n = 0; n < BL_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, params.size[n]);
+    }
+
+    const Box domain(IntVect(AMREX_D_DECL(0, 0, 0)),
+                     IntVect(AMREX_D_DECL(params.size[0]-1,params.size[1]-1,params.size[2]-1)));
+    Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+    Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    // cutoff + skin fits in one cell
+    const int ncells = 1;
+    VerletTestPC pc(geom, dm, ba, ncells);
+    VerletTestPC pc_ref(geom, dm, ba, ncells);
+    pc.setVerletSkin(VerletParams::skin);
+
+    const Long np = 10*domain.numPts();
+    VerletPC::ParticleInitData pdata = {{AMREX_D_DECL(0.0, 0.0, 0.0)}, {}, {}, {}};
+    pc.InitRandom(np, 451, pdata, true);
+    pc_ref.InitRandom(np, 451, pdata, true);
+    setVelocities(pc);
+    setVelocities(pc_ref);
+
+    const Real rv = VerletParams::cutoff + VerletParams::skin;
+    const CheckPairWithin check_verlet{rv*rv};
+    const CheckPairWithin check_ref{VerletParams::cutoff*VerletParams::cutoff};
+
+    const int nsteps = 20;
+    int nrebuilds = 0;
+    for (int step = 0; step < nsteps; ++step)
+    {
+        if (pc.updateNeighborList(check_verlet)) { ++nrebuilds; }
+
+        pc_ref.Redistribute();
+        pc_ref.fillNeighbors();
+        pc_ref.buildNeighborList(check_ref);
+
+        const Long n = countPairs(pc, pc.neighborList());
+        const Long n_ref = countPairs(pc_ref, pc_ref.neighborList());
+        AMREX_ALWAYS_ASSERT(n == n_ref && n > 0);
+
+        moveParticles(pc);
+        moveParticles(pc_ref);
+    }
+
+    amrex::Print() << "Verlet list: " << nrebuilds << " rebuilds in " << nsteps << " steps\n";
+    AMREX_ALWAYS_ASSERT(nrebuilds > 1 && nrebuilds < nsteps);
+}
+
+// The int array component holds the bin type, 0 unless setAlternatingBinTypes is called
+using HalfPC = amrex::NeighborParticleContainer<2*AMREX_SPACEDIM, 0, 0, 1>;
+
+struct PairForce
+{
+    template <class P>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    GpuArray<ParticleReal,AMREX_SPACEDIM> operator() (const P& p1, const P& p2) const
+    {
+        GpuArray<ParticleReal,AMREX_SPACEDIM> f{};
+        ParticleReal r2 = 0;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            f[d] = p1.pos(d) - p2.pos(d);
+            r2 += f[d]*f[d];
+        }
+        const ParticleReal w = (r2 < VerletParams::cutoff*VerletParams::cutoff)
+            ? ParticleReal(1.0) - std::sqrt(r2)/VerletParams::cutoff : ParticleReal(0.0);
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) { f[d] *= w; }
+        return f;
+    }
+};
+
+struct HalfTestPC : public HalfPC
+{
+    using HalfPC::HalfPC;
+
+    // Components [0, AMREX_SPACEDIM) with the full list, no ghost communication
+    void computeFullListForces ()
+    {
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti) {
+            const auto index = std::make_pair(pti.index(), pti.LocalTileIndex());
+            auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            auto nbor_data = m_neighbor_list[0][index].data();
+            amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i)
+            {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) { pstruct[i].rdata(d) = 0; }
+                for (const auto& p2 : nbor_data.getNeighbors(i)) {
+                    const auto f = PairForce{}(pstruct[i], p2);
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) { pstruct[i].rdata(d) += f[d]; }
+                }
+            });
+        }
+    }
+
+    // Largest difference between the two sets of components
+    Real maxForceDifference ()
+    {
+        Real maxdiff = 0;
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti) {
+            const auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            for (int i = 0; i < pti.numParticles(); ++i) {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    maxdiff = amrex::max(maxdiff, Real(std::abs(pstruct[i].rdata(d) -
+                                                                pstruct[i].rdata(AMREX_SPACEDIM+d))));
+                }
+            }
+        }
+        ParallelDescriptor::ReduceRealMax(maxdiff);
+        return maxdiff;
+    }
+
+    Long numListedPairs ()
+    {
+        Long n = 0;
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti) {
+            n += m_neighbor_list[0][std::make_pair(pti.index(), pti.LocalTileIndex())].GetList().size();
+        }
+        ParallelDescriptor::ReduceLongSum(n);
+        return n;
+    }
+
+    // Alternate the bin type of the real particles between 0 and 1
+    void setAlternatingBinTypes ()
+    {
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti) {
+            const auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            auto* ptype = pti.GetStructOfArrays().GetIntData(0).dataPtr();
+            for (int i = 0; i < pti.numParticles(); ++i) { ptype[i] = int(pstruct[i].id() % 2); }
+        }
+    }
+
+    void zeroHalfListForces ()
+    {
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti) {
+            auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            for (int i = 0; i < pti.numParticles(); ++i) {
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) { pstruct[i].rdata(AMREX_SPACEDIM+d) = 0; }
+            }
+        }
+    }
+};
+
+void testHalfNeighborList ()
+{
+    BL_PROFILE("testHalfNeighborList()");
+    TestParams params;
+    get_test_params(params, "nbor_list");
+
+    RealBox real_box;
+    for (int n = 0; n < BL_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, params.size[n]);
+    }
+
+    const Box domain(IntVect(AMREX_D_DECL(0, 0, 0)),
+                     IntVect(AMREX_D_DECL(params.size[0]-1,params.size[1]-1,params.size[2]-1)));
+    Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(1,1,1)};
+    Geometry geom(domain, real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    const int ncells = 1;
+    HalfTestPC pc(geom, dm, ba, ncells);
+    pc.setEnableInverse(true);
+
+    HalfPC::ParticleInitData pdata = {{}, {}, {}, {}};
+    pc.InitRandom(10*domain.numPts(), 2718, pdata, true);
+    pc.Redistribute();
+    pc.fillNeighbors();
+
+    const CheckPairWithin check{VerletParams::cutoff*VerletParams::cutoff};
+    pc.buildNeighborList(check);
+    const Long nfull = pc.numListedPairs();
+    pc.computeFullListForces();
+
+    pc.setHalfNeighborList(true);
+    pc.buildNeighborList(check);
+    const Long nhalf = pc.numListedPairs();
+    amrex::Print() << "Half neighbor list: " << nhalf << " of " << nfull << " pairs\n";
+    AMREX_ALWAYS_ASSERT(nfull > 0 && 2*nhalf == nfull);
+
+    for (auto method : {NeighborPairAccumulation::ThreadScratch,
+                        NeighborPairAccumulation::CellColoring})
+    {
+        pc.zeroHalfListForces();
+        pc.forEachNeighborPair<AMREX_SPACEDIM>(AMREX_SPACEDIM, PairForce{}, method);
+        const Real maxdiff = pc.maxForceDifference();
+        amrex::Print() << "Half list forces differ from full list forces by " << maxdiff << "\n";
+        AMREX_ALWAYS_ASSERT(maxdiff < 1.e-10);
+    }
+
+    // the overload taking bin types builds half lists too
+    int ref_ratio[1] = {1};
+    pc.buildNeighborList(check, 0, ref_ratio);
+    AMREX_ALWAYS_ASSERT(pc.numListedPairs() == nhalf);
+    for (auto method : {NeighborPairAccumulation::ThreadScratch,
+                        NeighborPairAccumulation::CellColoring})
+    {
+        pc.zeroHalfListForces();
+        pc.forEachNeighborPair<AMREX_SPACEDIM>(AMREX_SPACEDIM, PairForce{}, method);
+        AMREX_ALWAYS_ASSERT(pc.maxForceDifference() < 1.e-10);
+    }
+
+    // with two bin types, pairs of different types are listed on the lower type only
+    pc.clearNeighbors();
+    pc.setAlternatingBinTypes();
+    pc.fillNeighbors();
+    int ref_ratio2[2] = {1, 1};
+    pc.buildNeighborList(check, 0, ref_ratio2, 2);
+    pc.zeroHalfListForces();
+    pc.forEachNeighborPair<AMREX_SPACEDIM>(AMREX_SPACEDIM, PairForce{});
+    const Real maxdiff = pc.maxForceDifference();
+    amrex::Print() << "Half list forces with two bin types differ by " << maxdiff << "\n";
+    AMREX_ALWAYS_ASSERT(maxdiff < 1.e-10);
+}
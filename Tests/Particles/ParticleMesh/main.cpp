@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 
 #include <AMReX.H>
 #include <AMReX_MultiFab.H>
@@ -16,9 +17,44 @@ struct TestParams {
   int nz;
   int max_grid_size;
   int nppc;
+  int nbench;
   bool verbose;
 };
 
+template <class Interp, class PC>
+double benchmarkDeposition (PC const& pc, MultiFab& rho, int nbench)
+{
+  using ParticleType = typename PC::ParticleType;
+  const auto plo = pc.Geom(0).ProbLoArray();
+  const auto dxi = pc.Geom(0).InvCellSizeArray();
+
+  auto deposit = [&] () {
+      amrex::ParticleToMesh(pc, rho, 0,
+          [=] AMREX_GPU_DEVICE (const ParticleType& p, amrex::Array4<amrex::Real> const& arr)
+          {
+              Interp interp(p, plo, dxi);
+              interp.ParticleToMesh(p, arr, 0, 0, 1,
+                  [=] AMREX_GPU_DEVICE (const ParticleType& part, int comp)
+                  {
+                      return part.rdata(comp);
+                  });
+          });
+  };
+
+  deposit(); // warm up
+
+  ParallelDescriptor::Barrier();
+  double t = amrex::second();
+  for (int i = 0; i < nbench; ++i) {
+      deposit();
+  }
+  Gpu::streamSynchronize();
+  t = amrex::second() - t;
+  ParallelDescriptor::ReduceRealMax(t);
+
+  return static_cast<double>(pc.TotalNumberOfParticles()) * nbench / t;
+}
+
 void testParticleMesh (TestParams& parms)
 {
 
@@ -146,6 +182,141 @@ void testParticleMesh (TestParams& parms)
                   });
       });
 
+  // Relative tolerance for results that differ only in the order of additions
+  const Real tol = Real(1.e5)*std::numeric_limits<Real>::epsilon();
+
+  // Dual grid: the particles live on smaller boxes with their own
+  // DistributionMapping, while the mesh keeps the large boxes and has no
+  // ghost cells. Deposition and gather must match the same-grid results.
+  {
+      using PData = MyParticleContainer::ParticleTileType::ConstParticleTileDataType;
+      auto subset = [=] AMREX_GPU_HOST_DEVICE (const PData& ptd, int i) -> int
+      {
+          return Long(ptd.id(i)) % 16 == 0;
+      };
+      MyParticleContainer samePC(geom, dmap, ba);
+      samePC.copyParticles(myPC, subset);
+      MyParticleContainer dualPC(geom, dmap, ba);
+      dualPC.copyParticles(myPC, subset);
+      BoxArray pba(domain);
+      pba.maxSize(parms.max_grid_size/2);
+      dualPC.SetParticleBoxArray(0, pba);
+      dualPC.SetParticleDistributionMap(0, DistributionMapping(pba));
+      dualPC.Redistribute();
+      AMREX_ALWAYS_ASSERT(dualPC.TotalNumberOfParticles() == samePC.TotalNumberOfParticles());
+
+      auto deposit_mass = [=] AMREX_GPU_DEVICE (const MyParticleContainer::ParticleType& p,
+                                                amrex::Array4<amrex::Real> const& rho)
+      {
+          ParticleInterpolator::Linear interp(p, plo, dxi);
+          interp.ParticleToMesh(p, rho, 0, 0, 1,
+              [=] AMREX_GPU_DEVICE (const MyParticleContainer::ParticleType& part, int comp)
+              {
+                  return part.rdata(comp);
+              });
+      };
+
+      MultiFab rho_same(ba, dmap, 1, 1);
+      amrex::ParticleToMesh(samePC, rho_same, 0, deposit_mass);
+      MultiFab rho_dual(ba, dmap, 1, 0);
+      for (int n = 0; n < 2; ++n) { // the second call reuses the cached buffer
+          amrex::ParticleToMesh(dualPC, rho_dual, 0, deposit_mass, true, IntVect(1));
+      }
+      MultiFab::Subtract(rho_dual, rho_same, 0, 0, 1, 0);
+      AMREX_ALWAYS_ASSERT(rho_dual.norm0() <= tol*rho_same.norm0());
+
+      // Gather a smooth field with x-dependent values to a particle component.
+      MultiFab field(ba, dmap, 1, 0);
+      for (MFIter mfi(field); mfi.isValid(); ++mfi) {
+          auto const& a = field.array(mfi);
+          ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+          {
+              a(i,j,k) = Real(i % 7);
+          });
+      }
+      MultiFab field_grown(ba, dmap, 1, 1);
+      field_grown.ParallelCopy(field, 0, 0, 1, IntVect(0), IntVect(1), geom.periodicity());
+
+      auto gather = [=] AMREX_GPU_DEVICE (MyParticleContainer::ParticleType& p,
+                                          amrex::Array4<const amrex::Real> const& arr)
+      {
+          ParticleInterpolator::Linear interp(p, plo, dxi);
+          p.rdata(1+AMREX_SPACEDIM) = 0.0;
+          interp.MeshToParticle(p, arr, 0, 1+AMREX_SPACEDIM, 1,
+              [=] AMREX_GPU_DEVICE (amrex::Array4<const amrex::Real> const& a,
+                                    int i, int j, int k, int comp)
+              {
+                  return a(i, j, k, comp);
+              },
+              [=] AMREX_GPU_DEVICE (MyParticleContainer::ParticleType& part,
+                                    int comp, amrex::Real val)
+              {
+                  part.rdata(comp) += ParticleReal(val);
+              });
+      };
+      amrex::MeshToParticle(samePC, field_grown, 0, gather);
+      amrex::MeshToParticle(dualPC, field, 0, gather, IntVect(1));
+
+      using PType = MyParticleContainer::ParticleType;
+      auto gathered_sum = [] (MyParticleContainer const& pc) {
+          Real s = amrex::ReduceSum(pc, [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
+          {
+              return p.rdata(1+AMREX_SPACEDIM);
+          });
+          ParallelDescriptor::ReduceRealSum(s);
+          return s;
+      };
+      const Real s_same = gathered_sum(samePC);
+      const Real s_dual = gathered_sum(dualPC);
+      AMREX_ALWAYS_ASSERT(std::abs(s_dual - s_same) <= tol*std::abs(s_same));
+  }
+
+  if (parms.nbench > 0) {
+      MultiFab rho_cic(ba, dmap, 1, 1);
+      MultiFab rho_tsc(ba, dmap, 1, 1);
+      double cic = benchmarkDeposition<ParticleInterpolator::Linear>(myPC, rho_cic, parms.nbench);
+      double tsc = benchmarkDeposition<ParticleInterpolator::Quadratic>(myPC, rho_tsc, parms.nbench);
+
+      // Same again with the deposition binning the particles by cell
+      const bool binned_deposition = ParticleContainerBase::binned_deposition;
+      ParticleContainerBase::binned_deposition = true;
+      MultiFab rho_cic_binned(ba, dmap, 1, 1);
+      MultiFab rho_tsc_binned(ba, dmap, 1, 1);
+      double cic_binned = benchmarkDeposition<ParticleInterpolator::Linear>(myPC, rho_cic_binned, parms.nbench);
+      double tsc_binned = benchmarkDeposition<ParticleInterpolator::Quadratic>(myPC, rho_tsc_binned, parms.nbench);
+      ParticleContainerBase::binned_deposition = binned_deposition;
+
+      // Same again with the particles stored in cell order
+      myPC.SortParticlesByCell();
+      MultiFab rho_cic_sorted(ba, dmap, 1, 1);
+      MultiFab rho_tsc_sorted(ba, dmap, 1, 1);
+      double cic_sorted = benchmarkDeposition<ParticleInterpolator::Linear>(myPC, rho_cic_sorted, parms.nbench);
+      double tsc_sorted = benchmarkDeposition<ParticleInterpolator::Quadratic>(myPC, rho_tsc_sorted, parms.nbench);
+
+      // Both schemes conserve mass, and the order of the particles only
+      // changes the order of the additions.
+      const Real total_mass = mass * Real(num_particles);
+      for (auto* rho : {&rho_cic, &rho_tsc, &rho_cic_binned, &rho_tsc_binned,
+                        &rho_cic_sorted, &rho_tsc_sorted}) {
+          AMREX_ALWAYS_ASSERT(std::abs(rho->sum(0) - total_mass) <= tol*total_mass);
+      }
+      for (auto* rho : {&rho_cic_binned, &rho_cic_sorted}) {
+          MultiFab::Subtract(*rho, rho_cic, 0, 0, 1, 0);
+          AMREX_ALWAYS_ASSERT(rho->norm0() <= tol*rho_cic.norm0());
+      }
+      for (auto* rho : {&rho_tsc_binned, &rho_tsc_sorted}) {
+          MultiFab::Subtract(*rho, rho_tsc, 0, 0, 1, 0);
+          AMREX_ALWAYS_ASSERT(rho->norm0() <= tol*rho_tsc.norm0());
+      }
+
+      amrex::Print() << "CIC deposits per second: " << cic
+                     << " (" << cic_binned << " binned by cell, "
+                     << cic_sorted << " with particles sorted by cell)\n"
+                     << "TSC deposits per second: " << tsc
+                     << " (" << tsc_binned << " binned by cell, "
+                     << tsc_sorted << " with particles sorted by cell)\n";
+  }
+
   WriteSingleLevelPlotfile("plot", partMF,
                            {"density", AMREX_D_DECL("vx", "vy", "vz")},
                            geom, 0.0, 0);
@@ -170,6 +341,9 @@ int main(int argc, char* argv[])
     amrex::Abort("Must specify at least one particle per cell");
   }
 
+  parms.nbench = 0;
+  pp.query("nbench", parms.nbench);
+
   parms.verbose = false;
   pp.query("verbose", parms.verbose);
 
@@ -60,6 +60,8 @@ public:
         }
     }
 
+    using amrex::ParticleContainerBase::effectiveRedistributeLocal;
+
     void RedistributeLocal (bool remove_neg=true)
     {
         const int lev_min = 0;
@@ -263,6 +265,41 @@ public:
         }
     }
 
+    void negateNotMultipleOf (int n)
+    {
+        BL_PROFILE("TestParticleContainer::negateNotMultipleOf");
+
+        for (int lev = 0; lev <= finestLevel(); ++lev)
+        {
+            auto& plev  = GetParticles(lev);
+            for(MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+            {
+                int gid = mfi.index();
+                int tid = mfi.LocalTileIndex();
+                auto& ptile = plev[std::make_pair(gid, tid)];
+                auto& aos   = ptile.GetArrayOfStructs();
+                ParticleType* pstruct = aos.data();
+                const size_t np = aos.numParticles();
+                amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (int i) noexcept
+                {
+                    ParticleType& p = pstruct[i];
+                    if (p.id() % n != 0) {
+                        p.id() = -p.id();
+                    }
+                });
+            }
+        }
+    }
+
+    Long localCapacity () const
+    {
+        Long nbytes = 0;
+        for (int lev = 0; lev <= finestLevel(); ++lev) {
+            for (const auto& kv : GetParticles(lev)) { nbytes += kv.second.capacity(); }
+        }
+        return nbytes;
+    }
+
     void checkAnswer () const
     {
         BL_PROFILE("TestParticleContainer::checkAnswer");
@@ -329,6 +366,8 @@ struct TestParams
     int sort;
     int test_level_lost = 0;
     int stable_redistribute = 0;
+    Real sort_locality_threshold = 0.0;
+    int local_redistribute = 0;
 };
 
 void testRedistribute();
@@ -363,6 +402,8 @@ void get_test_params(TestParams& params, const std::string& prefix)
 
     params.sort = 0;
     pp.query("sort", params.sort);
+    pp.query("sort_locality_threshold", params.sort_locality_threshold);
+    pp.query("local_redistribute", params.local_redistribute);
 }
 
 void testRedistribute ()
@@ -413,7 +454,11 @@ void testRedistribute ()
 
     TestParticleContainer pc(geom, dm, ba, rr);
     pc.setStableRedistribute(params.stable_redistribute);
-
+    if (params.sort_locality_threshold > 0.0) {
+        ParticleSortPolicy policy;
+        policy.locality_threshold = params.sort_locality_threshold;
+        pc.SetSortPolicy(policy);
+    }
     IntVect nppc(params.num_ppc);
 
     amrex::Print() << "About to initialize particles \n";
@@ -439,6 +484,31 @@ void testRedistribute ()
         pc.RedistributeLocal();
         if (params.sort) { pc.SortParticlesByCell(); }
         pc.checkAnswer();
+        if (params.sort_locality_threshold > 0.0) {
+            for (int lev = 0; lev < params.nlevs; ++lev) {
+                for (MFIter mfi = pc.MakeMFIter(lev); mfi.isValid(); ++mfi) {
+                    AMREX_ALWAYS_ASSERT(pc.ParticleLocality(lev, mfi, IntVect(1)) >=
+                                        params.sort_locality_threshold);
+                }
+            }
+        }
+    }
+
+    // particles move at most one cell per step, so the plain Redistribute
+    // may use the neighbor-only algorithm while the grids do not change
+    const int expected_local = (params.nlevs == 1) ? params.local_redistribute : 0;
+    if (params.local_redistribute > 0)
+    {
+        pc.setLocalRedistribute(params.local_redistribute);
+        AMREX_ALWAYS_ASSERT(pc.effectiveRedistributeLocal(0, -1, 0) == expected_local);
+        AMREX_ALWAYS_ASSERT(pc.effectiveRedistributeLocal(0, -1, 2) == 2);
+        for (int i = 0; i < params.nsteps; ++i)
+        {
+            pc.moveParticles(params.move_dir, params.do_random);
+            pc.Redistribute();
+            pc.checkAnswer();
+            AMREX_ALWAYS_ASSERT(pc.effectiveRedistributeLocal(0, -1, 0) == expected_local);
+        }
     }
 
     if (params.do_regrid)
@@ -453,6 +523,8 @@ void testRedistribute ()
                 new_dm.define(pmap);
                 pc.SetParticleDistributionMap(lev, new_dm);
             }
+            // the particles may be anywhere after a regrid
+            AMREX_ALWAYS_ASSERT(pc.effectiveRedistributeLocal(0, -1, 0) == 0);
             if (!remove_negative) {
                 auto old = pc.TotalNumberOfParticles();
                 pc.negateEven();
@@ -462,6 +534,7 @@ void testRedistribute ()
             }
             pc.RedistributeGlobal();
             pc.checkAnswer();
+            AMREX_ALWAYS_ASSERT(pc.effectiveRedistributeLocal(0, -1, 0) == expected_local);
         }
 
         {
@@ -503,6 +576,58 @@ void testRedistribute ()
         AMREX_ALWAYS_ASSERT(np_old == pc.TotalNumberOfParticles());
     }
 
+    // the send buffers are reused across calls, so alternate between the local
+    // and the global algorithm, which send to different sets of ranks
+    for (int i = 0; i < 2*params.nsteps; ++i)
+    {
+        auto old = pc.TotalNumberOfParticles();
+        pc.moveParticles(params.move_dir, params.do_random);
+        if (i % 2 == 0) {
+            pc.RedistributeLocal();
+        } else {
+            pc.RedistributeGlobal();
+        }
+        pc.checkAnswer();
+        if (geom[0].isAllPeriodic()) {
+            AMREX_ALWAYS_ASSERT(old == pc.TotalNumberOfParticles());
+        }
+    }
+
+    // with particles.shrink_threshold set, Redistribute gives back the capacity
+    // of the tiles that lost most of their particles
+    if (pc.ShrinkThreshold() > 0.0)
+    {
+        using PType = TestParticleContainer::SuperParticleType;
+        Long np_keep = amrex::ReduceSum(pc, [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Long
+                                            { return (p.id() % 4 == 0) ? 1 : 0; });
+        ParallelDescriptor::ReduceLongSum(np_keep);
+        Long cap_old = pc.localCapacity();
+        ParallelDescriptor::ReduceLongSum(cap_old);
+        pc.negateNotMultipleOf(4);
+        pc.Redistribute();
+        pc.checkAnswer();
+        Long cap_new = pc.localCapacity();
+        ParallelDescriptor::ReduceLongSum(cap_new);
+        amrex::Print() << "Shrinking sparse tiles reduced the capacity from " << cap_old
+                       << " to " << cap_new << " bytes\n";
+        AMREX_ALWAYS_ASSERT(pc.TotalNumberOfParticles() == np_keep);
+        AMREX_ALWAYS_ASSERT(cap_new < cap_old);
+        AMREX_ALWAYS_ASSERT(pc.ShrinkSparseTiles(pc.ShrinkThreshold()) == 0);
+    }
+
+    // the tiles and Redistribute buffers have slack left from the moves above
+    Long nreleased = pc.ShrinkToFit();
+    ParallelDescriptor::ReduceLongSum(nreleased);
+    amrex::Print() << "ShrinkToFit released " << nreleased << " bytes\n";
+    for (int lev = 0; lev < params.nlevs; ++lev) {
+        for (const auto& kv : pc.GetParticles(lev)) {
+            const auto& ptile = kv.second;
+            if (ptile.numTotalParticles() == 0) { AMREX_ALWAYS_ASSERT(ptile.capacity() == 0); }
+        }
+    }
+    AMREX_ALWAYS_ASSERT(pc.ShrinkToFit() == 0);
+    pc.checkAnswer();
+
     // the way this test is set up, if we make it here we pass
     amrex::Print() << "pass \n";
 }